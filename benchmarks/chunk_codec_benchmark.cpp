@@ -0,0 +1,251 @@
+#include <benchmark/benchmark.h>
+#include <data/models/LivePreset.h>
+#include <data/models/StringProjectStateContext.h>
+#include <data/models/base/BaseTrackInfo.h>
+#include <data/models/base/BaseSendInfo.h>
+#include <util/ChunkCodec.h>
+#include <util/util.h>
+#include <cstdio>
+#include <memory>
+#include <random>
+
+namespace {
+
+//the REAPER api is not loaded in benchmarks, the chunks only need guids that are written back unchanged
+void formatGuid(const GUID* guid, char* dest) {
+    snprintf(dest, 64, "{%08X-%04X-%04X-%02X%02X-%02X%02X%02X%02X%02X%02X}", (unsigned) guid->Data1, guid->Data2,
+            guid->Data3, guid->Data4[0], guid->Data4[1], guid->Data4[2], guid->Data4[3], guid->Data4[4],
+            guid->Data4[5], guid->Data4[6], guid->Data4[7]);
+}
+
+void parseGuid(const char* str, GUID* guid) {
+    unsigned int parts[11] = {};
+    sscanf(str, "{%8X-%4X-%4X-%2X%2X-%2X%2X%2X%2X%2X%2X}", &parts[0], &parts[1], &parts[2], &parts[3], &parts[4],
+            &parts[5], &parts[6], &parts[7], &parts[8], &parts[9], &parts[10]);
+    guid->Data1 = parts[0];
+    guid->Data2 = (unsigned short) parts[1];
+    guid->Data3 = (unsigned short) parts[2];
+    for (int i = 0; i < 8; i++) {
+        guid->Data4[i] = (unsigned char) parts[3 + i];
+    }
+}
+
+std::string randomGuid(std::mt19937& rng) {
+    GUID guid;
+    guid.Data1 = rng();
+    guid.Data2 = (unsigned short) rng();
+    guid.Data3 = (unsigned short) rng();
+    for (auto& byte : guid.Data4) {
+        byte = (unsigned char) rng();
+    }
+    char dest[64];
+    formatGuid(&guid, dest);
+    return dest;
+}
+
+void appendParameter(std::string& text, const char* key, double value) {
+    char number[32];
+    FormatDouble(value, number, sizeof(number));
+    text += key;
+    text += " ";
+    text += number;
+    text += " 0\n";
+}
+
+/**
+ * The preset part of LivePresetsModel, the model itself needs the running extension for the recall actions
+ */
+class PresetList : public Persistable {
+public:
+    std::vector<LivePreset*> mPresets;
+    bool mIsBinaryChunk = false;
+
+    PresetList(const PresetList& other) = delete;
+    PresetList& operator=(const PresetList& other) = delete;
+    PresetList() = default;
+
+    ~PresetList() {
+        for (auto* preset : mPresets) {
+            delete preset;
+        }
+    }
+
+    /**
+     * Reads a chunk written by persist() like LivePresetsModel, binary chunks are decoded afterwards
+     */
+    void load(const WDL_FastString& chunk) {
+        auto ctx = StringProjectStateContext(chunk);
+        char line[64];
+        ctx.GetLine(line, sizeof(line));
+        initFromChunk((ProjectStateContext*) &ctx);
+
+        auto chunks = std::move(mEncodedChunks);
+        mEncodedChunks.clear();
+        for (const auto& [version, base64] : chunks) {
+            std::string data;
+            std::string text;
+            if (version != ChunkCodec::VERSION || !ChunkCodec::decodeBase64(base64, data)
+                    || !ChunkCodec::decode(data, text))
+                continue;
+
+            text += ">\n";
+            auto decoded = WDL_FastString();
+            decoded.Set(text.data(), (int) text.size());
+            auto decodedCtx = StringProjectStateContext(decoded);
+            initFromChunk((ProjectStateContext*) &decodedCtx);
+        }
+    }
+protected:
+    void persistHandler(ChunkWriter& str) const override {
+        for (const auto* preset : mPresets) {
+            preset->persistCached(str, mIsBinaryChunk);
+        }
+    }
+
+    bool initFromChunkHandler(std::string_view key, std::vector<const char*>& params) override {
+        if (key == "ENCODING") {
+            mEncodedChunks.emplace_back(ParseInt(params[0]), "");
+            return true;
+        }
+        if (key == "DATA" && !mEncodedChunks.empty()) {
+            mEncodedChunks.back().second += params[0];
+            return true;
+        }
+        return false;
+    }
+
+    bool initFromChunkHandler(std::string_view key, ProjectStateContext* ctx) override {
+        if (key == "LIVEPRESET") {
+            //a recall command id skips registering the recall action
+            mPresets.push_back(new LivePreset(ctx, 1));
+            return true;
+        }
+        return false;
+    }
+private:
+    std::vector<std::pair<int, std::string>> mEncodedChunks;
+
+    [[nodiscard]] std::string getChunkId() const override {
+        return "LIVEPRESETSMODEL";
+    }
+};
+
+//presets of 32 tracks with 2 fxs of 16 parameters and 2 sends each, the tracks are the same in every preset like in a
+//real project
+std::unique_ptr<PresetList> createPresets(size_t presets) {
+    guidToString = formatGuid;
+    stringToGuid = parseGuid;
+
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+
+    std::vector<std::string> tracks;
+    for (int i = 0; i < 32; i++) {
+        tracks.push_back(randomGuid(rng));
+    }
+
+    std::string text = "<LIVEPRESETSMODEL\n";
+    for (size_t p = 0; p < presets; p++) {
+        text += "<LIVEPRESET\nFILTERMODE 0\nGUID " + randomGuid(rng) + "\nNAME \"preset " + std::to_string(p)
+                + "\"\nDESC \"\"\nDATE 1600000000\nRECALLID " + std::to_string(p + 1) + "\n";
+
+        text += "<MASTERTRACKINFO\n<PARAMETERINFO\n";
+        for (size_t i = 0; i < MASTER_PARAM_COUNT; i++) {
+            appendParameter(text, TRACK_PARAM_KEYS[i], dist(rng));
+        }
+        text += "FILTERMODE 0\n>\nFILTERMODE 0\n>\n";
+
+        for (const auto& track : tracks) {
+            text += "<TRACKINFO\n<PARAMETERINFO\n";
+            for (const auto* key : TRACK_PARAM_KEYS) {
+                appendParameter(text, key, dist(rng));
+            }
+            text += "FILTERMODE 0\n>\nFILTERMODE 0\n";
+
+            for (int f = 0; f < 2; f++) {
+                text += "<FXINFO\n<PARAMETERINFO\n";
+                for (int i = 0; i < 16; i++) {
+                    appendParameter(text, std::to_string(i).data(), dist(rng));
+                }
+                text += "FILTERMODE 0\n>\nFILTERMODE 0\nGUID " + randomGuid(rng) + "\nTRACKGUID " + track
+                        + "\nNAME \"fx\"\nENABLED 1 0\nINDEX " + std::to_string(f) + " 0\nPRESET \"default\" 0\n>\n";
+            }
+            text += "GUID " + track + "\nNAME \"track\" 0\n";
+
+            for (int s = 0; s < 2; s++) {
+                text += "<SWSENDINFO\n<PARAMETERINFO\n";
+                for (const auto* key : SEND_PARAM_KEYS) {
+                    appendParameter(text, key, dist(rng));
+                }
+                text += "FILTERMODE 0\n>\nFILTERMODE 0\nSRCGUID " + track + "\nDSTGUID " + tracks[(size_t) s] + "\n>\n";
+            }
+            text += ">\n";
+        }
+        text += ">\n";
+    }
+    text += ">\n";
+
+    auto chunk = WDL_FastString();
+    chunk.Set(text.data(), (int) text.size());
+    auto list = std::make_unique<PresetList>();
+    list->load(chunk);
+    return list;
+}
+
+//every preset changed since the last save, so all of them are serialized and for the binary chunk encoded again
+void BM_chunk_save(benchmark::State& state) {
+    auto list = createPresets((size_t) state.range(0));
+    list->mIsBinaryChunk = state.range(1) != 0;
+    auto chunk = WDL_FastString();
+
+    for (auto _ : state) {
+        for (auto* preset : list->mPresets) {
+            preset->mChunkCache.invalidate();
+        }
+        chunk.Set("");
+        list->persist(chunk);
+        benchmark::DoNotOptimize(chunk.Get());
+    }
+    state.counters["bytes"] = (double) chunk.GetLength();
+}
+
+//no preset changed, both formats write the cached chunks of the last save
+void BM_chunk_save_unchanged(benchmark::State& state) {
+    auto list = createPresets((size_t) state.range(0));
+    list->mIsBinaryChunk = state.range(1) != 0;
+    auto chunk = WDL_FastString();
+    list->persist(chunk);
+
+    for (auto _ : state) {
+        chunk.Set("");
+        list->persist(chunk);
+        benchmark::DoNotOptimize(chunk.Get());
+    }
+    state.counters["bytes"] = (double) chunk.GetLength();
+}
+
+void BM_chunk_load(benchmark::State& state) {
+    auto list = createPresets((size_t) state.range(0));
+    list->mIsBinaryChunk = state.range(1) != 0;
+    auto chunk = WDL_FastString();
+    list->persist(chunk);
+
+    for (auto _ : state) {
+        auto loaded = std::make_unique<PresetList>();
+        loaded->load(chunk);
+        if (loaded->mPresets.size() != list->mPresets.size())
+            state.SkipWithError("loading failed");
+
+        state.PauseTiming();
+        loaded.reset();
+        state.ResumeTiming();
+    }
+    state.counters["bytes"] = (double) chunk.GetLength();
+}
+
+}
+
+//the second argument selects the binary chunk
+BENCHMARK(BM_chunk_save)->ArgsProduct({{1, 10, 100}, {0, 1}});
+BENCHMARK(BM_chunk_save_unchanged)->ArgsProduct({{1, 10, 100}, {0, 1}});
+BENCHMARK(BM_chunk_load)->ArgsProduct({{1, 10, 100}, {0, 1}});
\ No newline at end of file
@@ -0,0 +1,57 @@
+#include <benchmark/benchmark.h>
+#include <util/util.h>
+#include <algorithm>
+#include <random>
+
+namespace {
+
+struct Item {
+    GUID mGuid;
+};
+
+GUID randomGuid(std::mt19937& rng) {
+    GUID guid{};
+    auto* data = reinterpret_cast<uint32_t*>(&guid);
+    for (size_t i = 0; i < sizeof(GUID) / sizeof(uint32_t); i++) {
+        data[i] = rng();
+    }
+    return guid;
+}
+
+//saved and current share 90% of the items in shuffled order, like a project after some edits
+void BM_reconcile(benchmark::State& state) {
+    auto size = (size_t) state.range(0);
+    std::mt19937 rng(42);
+
+    std::vector<Item> items;
+    for (size_t i = 0; i < size; i++) {
+        items.push_back({randomGuid(rng)});
+    }
+
+    std::vector<GUID> current;
+    for (size_t i = size / 10; i < size; i++) {
+        current.push_back(items[i].mGuid);
+    }
+    for (size_t i = 0; i < size / 10; i++) {
+        current.push_back(randomGuid(rng));
+    }
+    std::shuffle(current.begin(), current.end(), rng);
+
+    for (auto _ : state) {
+        auto saved = items;
+        size_t matched = 0;
+        size_t added = 0;
+        reconcile<GUID, GuidHash, GuidEqual>(saved, current,
+                [](const Item& a) -> const GUID& { return a.mGuid; },
+                [](const GUID& b) -> const GUID& { return b; },
+                [&matched](const Item&, const GUID&) { matched++; },
+                [&added](const GUID&) { added++; });
+        benchmark::DoNotOptimize(matched);
+        benchmark::DoNotOptimize(added);
+    }
+    state.SetComplexityN(state.range(0));
+}
+
+}
+
+BENCHMARK(BM_reconcile)->RangeMultiplier(10)->Range(10, 10000)->Complexity(benchmark::oN);
\ No newline at end of file
@@ -96,7 +96,9 @@ static bool loadAPI(void* (*getFunc)(const char*)) {
             REQUIRED_API(TrackList_AdjustWindows),
             REQUIRED_API(GetLastTouchedFX),
             REQUIRED_API(GetMediaTrackInfo_Value),
-            REQUIRED_API(GetCurrentProjectInLoadSave)
+            REQUIRED_API(GetCurrentProjectInLoadSave),
+            REQUIRED_API(GetProjectStateChangeCount),
+            REQUIRED_API(ValidatePtr2)
     };
 
     for (const ApiFunc &func : funcs) {
@@ -163,18 +165,24 @@ static void hookMenuProc(const char* menustr, HMENU hMenu, int flag) {
  *          1 = action belongs to this extension and is currently set to "on"
  */
 static int toggleActionProc(int iCmd) {
-    if (iCmd == NamedCommandLookup("_LPE_OPENTOGGLE_MAIN")) {
+    if (!g_lpe->mActions.contains(iCmd)) {
+        return -1;
+    }
+    if (iCmd == g_lpe->mToggleMainCmdId) {
         return g_lpe->mController.isVisible();
     }
-    if (iCmd == NamedCommandLookup("_LPE_TOGGLEMUTEDVISIBILITY")) {
+    if (iCmd == g_lpe->mToggleMutedCmdId) {
         return LPE::isMutedShown();
     }
-    if (iCmd == NamedCommandLookup("_LPE_OPENTOGGLE_CONTROL")) {
+    if (iCmd == g_lpe->mToggleControlCmdId) {
         return ControlViewController_IsVisible(&g_lpe->mControlView);
     }
-    if (iCmd == NamedCommandLookup("_LPE_OPENTOGGLE_ABOUT")) {
+    if (iCmd == g_lpe->mToggleAboutCmdId) {
         return g_lpe->mAboutController.isVisible();
     }
+    if (iCmd == g_lpe->mToggleProfilingCmdId) {
+        return g_lpe->mProfiler.isEnabled();
+    }
 
     return -1;
 }
@@ -29,7 +29,6 @@
 
 
 
-#include <sstream>
 #include <functional>
 #include <memory>
 #include <liblpe/LivePresetsExtension.h>
@@ -45,19 +44,19 @@ Main entry point, is called when the extension is loaded.
 */
 LPE::LPE(REAPER_PLUGIN_HINSTANCE hInstance, HWND mainHwnd) : mInstance(hInstance), mMainHwnd(mainHwnd) {
     //register commands and project config with reaper
-    mActions.add(new HotkeyCommand(
+    mToggleMainCmdId = mActions.add(new HotkeyCommand(
             "LPE_OPENTOGGLE_MAIN",
             "LPE - Opens/Closes the LivePresetsExtension main window",
             std::bind(&LPE::toggleMainWindow, this)
     ));
 
-    mActions.add(new HotkeyCommand(
+    mToggleAboutCmdId = mActions.add(new HotkeyCommand(
             "LPE_OPENTOGGLE_ABOUT",
             "LPE - Opens/Closes the LivePresetsExtension about window",
             std::bind(&LPE::toggleAboutWindow, this)
     ));
 
-    mActions.add(new HotkeyCommand(
+    mToggleControlCmdId = mActions.add(new HotkeyCommand(
             "LPE_OPENTOGGLE_CONTROL",
             "LPE - Opens/Closes the LivePresetsExtension ControlView window",
             std::bind(&LPE::toggleControlView, this)
@@ -69,7 +68,7 @@ LPE::LPE(REAPER_PLUGIN_HINSTANCE hInstance, HWND mainHwnd) : mInstance(hInstance
             std::bind(&LPE::onApplySelectedTrackConfigsToAllPresets, this)
     ));
 
-    mActions.add(new HotkeyCommand(
+    mToggleMutedCmdId = mActions.add(new HotkeyCommand(
             "LPE_TOGGLEMUTEDVISIBILITY",
             "LPE - Shows/Hides muted tracks in TCP",
             std::bind(&LPE::toggleMutedTracksVisibility, this)
@@ -105,6 +104,18 @@ LPE::LPE(REAPER_PLUGIN_HINSTANCE hInstance, HWND mainHwnd) : mInstance(hInstance
             std::bind(&LPE::showSettings, this)
     ));
 
+    mActions.add(new HotkeyCommand(
+            "LPE_RECALLREPORT",
+            "LPE - Writes the recall timing report to the resource path",
+            std::bind(&LPE::writeRecallReport, this)
+    ));
+
+    mToggleProfilingCmdId = mActions.add(new HotkeyCommand(
+            "LPE_TOGGLERECALLPROFILING",
+            "LPE - Enables/Disables recall profiling",
+            std::bind(&LPE::toggleRecallProfiling, this)
+    ));
+
     using namespace std::placeholders;
     mActions.add(new ActionCommand(
             "LPE_SELECTPRESET",
@@ -278,11 +289,29 @@ void LPE::showSettings() {
     mController.showSettings();
 }
 
+/**
+ * Writes the measured recall durations to LPE_recall_report.txt in the resource path
+ */
+void LPE::writeRecallReport() {
+    auto resPath = std::string(GetResourcePath()) + "/LPE_recall_report.txt";
+    auto msg = mProfiler.writeReport(resPath)
+            ? "LPE - Recall report written to " + resPath + "\n"
+            : "LPE - Could not write recall report to " + resPath + "\n";
+    ShowConsoleMsg(msg.data());
+}
+
+/**
+ * Recall durations are only measured while profiling is enabled, it is off on every start
+ */
+void LPE::toggleRecallProfiling() {
+    mProfiler.setEnabled(!mProfiler.isEnabled());
+}
+
 /*
- * Recall a preset by its GUID which is encoded in all 4 variables
+ * Recall a preset of the current project by its GUID
  */
-void LPE::recallPresetByGuid(int data1, int data2, int data3, int data4) {
-    mModel->recallPresetByGuid(IntsToGuid(data1, data2, data3, data4));
+void LPE::recallPresetByGuid(const GUID& guid) {
+    mModel->recallPresetByGuid(guid);
 }
 
 /**
@@ -310,15 +339,7 @@ void LPE::onRecallPreset(int val, int valhw, int, HWND) {
  * Returns if there is a muted track shown in TCP
  */
 bool LPE::isMutedShown() {
-    bool mutedShown = false;
-    for (int i = 0; i < GetNumTracks(); i++) {
-        MediaTrack* track = GetTrack(nullptr, i);
-
-        if (GetMediaTrackInfo_Value(track, B_MUTE) != 0) {
-            mutedShown = mutedShown || GetMediaTrackInfo_Value(track, B_SHOWINTCP) != 0;
-        }
-    }
-    return mutedShown;
+    return g_lpe->mModel && g_lpe->mModel->mMutedTracks.isMutedShown();
 }
 
 /**
@@ -335,6 +356,8 @@ void LPE::toggleMutedTracksVisibility() {
             SetMediaTrackInfo_Value(track, B_SHOWINTCP, !mutedShown);
         }
     }
+    if (mModel)
+        mModel->mMutedTracks.invalidate();
 
     TrackList_AdjustWindows(true);
 }
@@ -375,6 +398,9 @@ void LPE::toggleAboutWindow() {
 void LPE::onProjectChanged(ReaProject *proj) {
     mProject = proj;
     mModel = &mModels[proj];
+    mModel->mTrackIndex.invalidate();
+    mModel->mFxIndex.invalidate();
+    mModel->mMutedTracks.invalidate();
     mController.reset();
     ControlViewController_Reset(&mControlView);
 }
@@ -382,7 +408,7 @@ void LPE::onProjectChanged(ReaProject *proj) {
 /*
  * Extension data is read here. Is also called on Undo/Redo to get an old persisted state
  */
-bool LPE::recallState(ProjectStateContext* ctx, bool) {
+bool LPE::recallState(ProjectStateContext* ctx, bool isUndo) {
     // Go through all lines until the src part ends
     char buf[4096];
     LineParser lp;
@@ -392,7 +418,8 @@ bool LPE::recallState(ProjectStateContext* ctx, bool) {
         auto *proj = GetCurrentProjectInLoadSave();
         const auto *token = lp.gettoken_str(0);
         if (strcmp(token, "<LIVEPRESETSMODEL") == 0) {
-            mModels[proj] = LivePresetsModel(ctx);
+            //undo and redo keep the presets that did not change
+            mModels[proj] = LivePresetsModel(ctx, isUndo ? &mModels[proj] : nullptr);
         }
 
         // data finished on >
@@ -416,14 +443,7 @@ void LPE::saveState(ProjectStateContext* ctx, bool) {
     if (mModels[proj].mPresets.empty())
         return;
 
-    WDL_FastString chunk;
-    mModels[proj].persist(chunk);
-
-    std::string out;
-    std::istringstream ss(chunk.Get());
-    while (getline(ss, out)) {
-        ctx->AddLine("%s", out.data());
-    }
+    mModels[proj].persist(ctx);
 }
 
 void LPE::resetState(bool) {
@@ -39,6 +39,7 @@
 #include <liblpe/controller/AboutController.h>
 #include <liblpe/util/ProjectChangeListener.h>
 #include <liblpe/controller/ControlViewController.h>
+#include <liblpe/util/RecallProfiler.h>
 
 /**
  * LPE = LivePresetsExtension, main class that manages the base classes statically
@@ -55,10 +56,17 @@ public:
     ControlViewController mControlView;
     AboutController mAboutController;
     ProjectChangeListener mChangeListener;
+    RecallProfiler mProfiler;
 
     REAPER_PLUGIN_HINSTANCE mInstance;
     HWND mMainHwnd;
     CommandList mActions;
+    //ids of the toggle actions, resolved on startup as reaper polls their state constantly
+    BaseCommand::CommandID mToggleMainCmdId = 0;
+    BaseCommand::CommandID mToggleAboutCmdId = 0;
+    BaseCommand::CommandID mToggleControlCmdId = 0;
+    BaseCommand::CommandID mToggleMutedCmdId = 0;
+    BaseCommand::CommandID mToggleProfilingCmdId = 0;
 
     static void onMenuClicked(const char* menustr, HMENU menu, int flag);
     static bool isMutedShown();
@@ -67,7 +75,7 @@ public:
     bool recallState(ProjectStateContext* ctx, bool isUndo);
     void saveState(ProjectStateContext* ctx, bool isUndo);
     void resetState(bool isUndo);
-    void recallPresetByGuid(int data1, int data2, int data3, int data4);
+    void recallPresetByGuid(const GUID& guid);
     void onRecallPreset(int val, int valhw, int relmode, HWND hwnd);
     void onProjectChanged(ReaProject* proj);
 private:
@@ -81,6 +89,8 @@ private:
     void toggleAboutWindow();
     void toggleControlView();
     void onApplySelectedTrackConfigsToAllPresets();
+    void writeRecallReport();
+    void toggleRecallProfiling();
 };
 
 inline std::unique_ptr<LPE> g_lpe;
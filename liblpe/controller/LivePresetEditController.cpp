@@ -72,10 +72,11 @@ void LivePresetEditController::onInitDlg() {
     auto comboAdapter = std::make_unique<FilterPresetsComboAdapter>(FilterPreset_GetNames(g_lpe->mModel->mFilterPresets));
     mCombo->setAdapter(std::move(comboAdapter));
 
+    //extract once and compare by hash
+    auto current = std::unique_ptr<FilterPreset>(mPreset->extractFilterPreset());
     int index = 0;
     for (auto *af : g_lpe->mModel->mFilterPresets) {
-        auto *bf = mPreset->extractFilterPreset();
-        if (FilterPreset_IsEqual(af, bf)) {
+        if (FilterPreset_IsEqual(af, current.get())) {
             SendMessage(mCombo->mHwnd, CB_SETCURSEL, index, 0);
         }
         index++;
@@ -162,7 +163,6 @@ void LivePresetEditController::onCommand(WPARAM wparam, LPARAM lparam) {
             showFilterSettings();
             break;
         case IDC_ADD: {
-            auto *filter = mPreset->extractFilterPreset();
             std::string name = "New preset";
             auto dlg = ConfirmationController("Save filter...", &name);
             if (dlg.show()) {
@@ -176,6 +176,7 @@ void LivePresetEditController::onCommand(WPARAM wparam, LPARAM lparam) {
                         return;
                     }
                 }
+                auto *filter = mPreset->extractFilterPreset();
                 filter->mId.name = name;
                 FilterPreset_AddPreset(g_lpe->mModel->mFilterPresets, filter);
                 mCombo->getAdapter()->mItems = FilterPreset_GetNames(g_lpe->mModel->mFilterPresets);
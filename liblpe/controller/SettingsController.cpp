@@ -49,6 +49,11 @@ void SettingsController::onInitDlg() {
     CheckDlgButton(mHwnd, IDC_RECALL_MUTED_PLUGINS, g_lpe->mModel->mIsLoadStateOnMute);
     CheckDlgButton(mHwnd, IDC_RECALL_ACTIVE_PRESETS, g_lpe->mModel->mIsReselectLivePresetByValueRecall);
     CheckDlgButton(mHwnd, IDC_HIDE_MUTED_TRACKS, g_lpe->mModel->mIsHideMutedTracks);
+    CheckDlgButton(mHwnd, IDC_COMPILE_RECALL, g_lpe->mModel->mIsCompileRecall);
+    CheckDlgButton(mHwnd, IDC_SHADOW_STATE, g_lpe->mModel->mIsShadowState);
+    CheckDlgButton(mHwnd, IDC_LAZY_LOAD, g_lpe->mModel->mIsLazyLoad);
+    CheckDlgButton(mHwnd, IDC_BINARY_CHUNK, g_lpe->mModel->mIsBinaryChunk);
+    SetDlgItemInt(mHwnd, IDC_SLICE_BUDGET, g_lpe->mModel->mRecallSliceBudget, false);
 
     //create combo add FilterPreset names and select default
     mCombo = std::make_unique<ComboBox>(GetDlgItem(mHwnd, IDC_COMBO));
@@ -77,6 +82,11 @@ void SettingsController::onCommand(WPARAM wParam, LPARAM lparam) {
         }
         return;
     }
+    //change recall slice budget
+    if (HIWORD(wParam) == EN_CHANGE && LOWORD(wParam) == IDC_SLICE_BUDGET) {
+        g_lpe->mModel->mRecallSliceBudget = (int) GetDlgItemInt(mHwnd, IDC_SLICE_BUDGET, nullptr, false);
+        return;
+    }
     switch (wParam) {
         case IDC_RECALL: {
             auto cmdId = NamedCommandLookup("_LPE_SELECTPRESET");
@@ -118,6 +128,18 @@ void SettingsController::onCommand(WPARAM wParam, LPARAM lparam) {
         case IDC_HIDE_MUTED_TRACKS:
             g_lpe->mModel->mIsHideMutedTracks = IsDlgButtonChecked(mHwnd, IDC_HIDE_MUTED_TRACKS);
             break;
+        case IDC_COMPILE_RECALL:
+            g_lpe->mModel->mIsCompileRecall = IsDlgButtonChecked(mHwnd, IDC_COMPILE_RECALL);
+            break;
+        case IDC_SHADOW_STATE:
+            g_lpe->mModel->mIsShadowState = IsDlgButtonChecked(mHwnd, IDC_SHADOW_STATE);
+            break;
+        case IDC_LAZY_LOAD:
+            g_lpe->mModel->mIsLazyLoad = IsDlgButtonChecked(mHwnd, IDC_LAZY_LOAD);
+            break;
+        case IDC_BINARY_CHUNK:
+            g_lpe->mModel->mIsBinaryChunk = IsDlgButtonChecked(mHwnd, IDC_BINARY_CHUNK);
+            break;
         case IDC_UPDATE: {
             SetTimer(mHwnd, 1, 0, updateAllPresets);
             break;
@@ -130,7 +152,7 @@ void CALLBACK SettingsController::updateAllPresets(HWND hwnd, UINT, UINT_PTR i,
     if (i - 1 < g_lpe->mModel->mPresets.size()) {
         LivePreset* preset = g_lpe->mModel->mPresets.at(i - 1);
         fprintf(stderr, "Updating: %s \n", preset->mName.data());
-        g_lpe->mModel->recallPreset(preset);
+        g_lpe->mModel->recallPreset(preset, false);
         preset->saveCurrentState(true);
 
         SetTimer(hwnd, i + 1, 100, updateAllPresets);
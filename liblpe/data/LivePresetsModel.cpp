@@ -29,16 +29,21 @@
 
 #include <liblpe/data/LivePresetsModel.h>
 #include <algorithm>
+#include <chrono>
 #include <reaper_plugin_functions.h>
 #include <liblpe/LivePresetsExtension.h>
 #include <liblpe/util/util.h>
+#include <liblpe/util/ChunkCodec.h>
+#include <liblpe/data/models/StringProjectStateContext.h>
 
 /*
  * Should be called to load LivePresetsModel from .rpp file.
  * ctx should contain the lines after <LIVEPRESETSMODEL
  */
-LivePresetsModel::LivePresetsModel(ProjectStateContext *ctx) {
+LivePresetsModel::LivePresetsModel(ProjectStateContext *ctx, LivePresetsModel* previous) : mPrevious(previous) {
     initFromChunk(ctx);
+    loadEncodedChunks();
+    releasePrevious();
 }
 
 LivePresetsModel::~LivePresetsModel() {
@@ -59,8 +64,25 @@ LivePresetsModel& LivePresetsModel::operator=(LivePresetsModel&& other) noexcept
     mIsLoadStateOnMute = other.mIsLoadStateOnMute;
     mIsReselectFxPreset = other.mIsReselectFxPreset;
     mIsReselectLivePresetByValueRecall = other.mIsReselectLivePresetByValueRecall;
+    mIsCompileRecall = other.mIsCompileRecall;
+    mIsShadowState = other.mIsShadowState;
+    mIsLazyLoad = other.mIsLazyLoad;
+    mIsBinaryChunk = other.mIsBinaryChunk;
+    mUndecodedChunks = std::move(other.mUndecodedChunks);
+    mRecallSliceBudget = other.mRecallSliceBudget;
     mDefaultFilterPreset = other.mDefaultFilterPreset;
 
+    //resolved tracks may belong to a different state of the project
+    mTrackIndex.invalidate();
+    mFxIndex.invalidate();
+    mShadowState.invalidate();
+    mMutedTracks.invalidate();
+    cancelSlicedRecall();
+    mTransitions.clear();
+    mLayoutValues.clear();
+    mIsStateChanged = true;
+    rebuildIndices();
+
     //make all pointers null and create empty containers for now empty instance other that its destruction does not
     //affect this instance
     other.mHardwares = std::vector<Hardware*>();
@@ -71,29 +93,59 @@ LivePresetsModel& LivePresetsModel::operator=(LivePresetsModel&& other) noexcept
     return *this;
 }
 
-bool LivePresetsModel::initFromChunkHandler(std::string &key, std::vector<const char *> &params) {
+bool LivePresetsModel::initFromChunkHandler(std::string_view key, std::vector<const char *> &params) {
     if (key == "VERSION") {
         //TODO check correct version
         return true;
     }
     if (key == "UNDO") {
-        mDoUndo = (bool) std::stoi(params[0]);
+        mDoUndo = (bool) ParseInt(params[0]);
         return true;
     }
     if (key == "HIDEMUTEDTRACKS") {
-        mIsHideMutedTracks = (bool) std::stoi(params[0]);
+        mIsHideMutedTracks = (bool) ParseInt(params[0]);
         return true;
     }
     if (key == "RESELECTPRESETS") {
-        mIsReselectLivePresetByValueRecall = (bool) std::stoi(params[0]);
+        mIsReselectLivePresetByValueRecall = (bool) ParseInt(params[0]);
         return true;
     }
     if (key == "RESELECTFXPRESETS") {
-        mIsReselectFxPreset = (bool) std::stoi(params[0]);
+        mIsReselectFxPreset = (bool) ParseInt(params[0]);
         return true;
     }
     if (key == "LOADMUTED") {
-        mIsLoadStateOnMute = (bool) std::stoi(params[0]);
+        mIsLoadStateOnMute = (bool) ParseInt(params[0]);
+        return true;
+    }
+    if (key == "COMPILERECALL") {
+        mIsCompileRecall = (bool) ParseInt(params[0]);
+        return true;
+    }
+    if (key == "SHADOWSTATE") {
+        mIsShadowState = (bool) ParseInt(params[0]);
+        return true;
+    }
+    if (key == "LAZYLOAD") {
+        mIsLazyLoad = (bool) ParseInt(params[0]);
+        return true;
+    }
+    if (key == "BINARYCHUNK") {
+        mIsBinaryChunk = (bool) ParseInt(params[0]);
+        return true;
+    }
+    if (key == "ENCODING") {
+        mEncodedChunks.emplace_back(ParseInt(params[0]), "");
+        return true;
+    }
+    if (key == "DATA") {
+        if (mEncodedChunks.empty())
+            mEncodedChunks.emplace_back(0, "");
+        mEncodedChunks.back().second += params[0];
+        return true;
+    }
+    if (key == "RECALLSLICEBUDGET") {
+        mRecallSliceBudget = ParseInt(params[0]);
         return true;
     }
     if (key == "DEFAULTFILTER") {
@@ -103,9 +155,11 @@ bool LivePresetsModel::initFromChunkHandler(std::string &key, std::vector<const
     return false;
 }
 
-bool LivePresetsModel::initFromChunkHandler(std::string &key, ProjectStateContext *ctx) {
+bool LivePresetsModel::initFromChunkHandler(std::string_view key, ProjectStateContext *ctx) {
     if (key == "LIVEPRESET") {
-        mPresets.push_back(new LivePreset(ctx));
+        auto* preset = mPrevious ? reloadPreset(ctx) : new LivePreset(ctx, 0, mIsLazyLoad);
+        mPresets.push_back(preset);
+        indexPreset(preset);
         return true;
     }
     if (key == "FILTERPRESET") {
@@ -127,6 +181,7 @@ LivePreset *LivePresetsModel::getCurrentSettingsAsPreset() const {
 
 void LivePresetsModel::addPreset(LivePreset *preset, bool saveUndo) {
     mPresets.push_back(preset);
+    indexPreset(preset);
     if (saveUndo) {
         Undo_OnStateChangeEx2(nullptr, "Add LivePreset", UNDO_STATE_MISCCFG, -1);
     }
@@ -136,45 +191,244 @@ void LivePresetsModel::addPreset(LivePreset *preset, bool saveUndo) {
  * Tries to find a preset with the given guid and recalls it
  * returns true when a preset was found
  */
-bool LivePresetsModel::recallPresetByGuid(GUID guid) {
-    for (auto* preset : mPresets) { // NOLINT(readability-use-anyofallof)
-        if (GuidsEqual(preset->mGuid, guid)) {
-            recallPreset(preset);
-            return true;
-        }
-    }
-    return false;
+bool LivePresetsModel::recallPresetByGuid(const GUID& guid) {
+    auto it = mPresetsByGuid.find(guid);
+    if (it == mPresetsByGuid.end())
+        return false;
+
+    recallPreset(it->second);
+    return true;
 }
 
 
-void LivePresetsModel::recallPreset(LivePreset* preset) {
+/**
+ * Recalls a preset. When compiled recall and a slice budget are set, the recall is split into slices that are
+ * executed from onRun()
+ * @param preset the preset to recall
+ * @param allowSliced false to always recall the whole preset before returning
+ */
+void LivePresetsModel::recallPreset(LivePreset* preset, bool allowSliced) {
     if (!preset)
         return;
 
+    //a new recall cancels a running sliced recall
+    cancelSlicedRecall();
+    g_lpe->mProfiler.begin(preset->mGuid, preset->mName);
+
+    if (allowSliced && mIsCompileRecall && mRecallSliceBudget > 0) {
+        mSlicedPlan = &getRecallPlan(preset);
+        mSlicedPreset = preset;
+        mSlicedPosition = 0;
+        mSlicedDuration = 0;
+        //the project is in between two presets until the recall is finished
+        mIsStateChanged = true;
+        onRun();
+        return;
+    }
+
+    RecallProfiler::Timer timer(RecallProfiler::TOTAL);
+    mShadowState.begin(mIsShadowState);
+
     if (mDoUndo) {
         Undo_BeginBlock();
         PreventUIRefresh(1);
-        preset->recallSettings();
+        recallSettings(preset);
         mActivePreset = preset;
+        RecallProfiler::Timer uiTimer(RecallProfiler::UI);
         if (g_lpe->mController.mList)
             g_lpe->mController.mList->invalidate();
         PreventUIRefresh(-1);
+        uiTimer.stop();
+        //the undo point has to contain the layout
+        applyLayoutValues();
         Undo_OnStateChangeEx2(nullptr, "Recall LivePreset", UNDO_STATE_ALL, -1);
         Undo_EndBlock("Recall LivePreset", UNDO_STATE_ALL);
     } else {
         PreventUIRefresh(1);
-        preset->recallSettings();
+        recallSettings(preset);
         mActivePreset = preset;
+        RecallProfiler::Timer uiTimer(RecallProfiler::UI);
         if (g_lpe->mController.mList)
             g_lpe->mController.mList->invalidate();
-        TrackList_AdjustWindows(true);
         PreventUIRefresh(-1);
     }
+
+    //changes made by the recall itself don't count
+    mShadowState.end();
+    mMutedTracks.invalidate();
+    mIsStateChanged = false;
+    mStateChangeCount = GetProjectStateChangeCount(nullptr);
+}
+
+/**
+ * Recalls the settings of a preset. When the project is still in the state of the active preset, only the
+ * differences to the active preset are recalled
+ */
+void LivePresetsModel::recallSettings(LivePreset* preset) {
+    if (!mIsCompileRecall) {
+        preset->recallSettings();
+        return;
+    }
+    getRecallPlan(preset).execute();
+}
+
+/**
+ * Returns the cached transition from the active preset when the project is still in its state, else the plan of the
+ * preset itself
+ */
+RecallPlan& LivePresetsModel::getRecallPlan(LivePreset* preset) {
+    if (!mActivePreset || mActivePreset == preset || !isActivePresetApplied())
+        return preset->getRecallPlan();
+
+    const auto& from = mActivePreset->getRecallPlan();
+    const auto& to = preset->getRecallPlan();
+    auto& transition = mTransitions[{mActivePreset, preset}];
+    if (!transition.isTransition(from, to))
+        transition.compileTransition(from, to);
+    return transition;
+}
+
+/**
+ * Called by ProjectChangeListener on every main loop cycle, executes the next slice of a sliced recall or applies the
+ * layout values once the recall is done
+ */
+void LivePresetsModel::onRun() {
+    if (mSlicedPreset)
+        executeSlice();
+    else if (!mLayoutValues.empty())
+        applyLayoutValues();
+}
+
+void LivePresetsModel::executeSlice() {
+    //tracks or the preset changed since the recall started
+    if (!mSlicedPlan->isValid() || !mSlicedPreset->mRecallPlan.isValid()) {
+        cancelSlicedRecall();
+        return;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    mShadowState.begin(mIsShadowState);
+    PreventUIRefresh(1);
+    mSlicedPosition = mSlicedPlan->executeSlice(mSlicedPosition, mRecallSliceBudget);
+    PreventUIRefresh(-1);
+    mShadowState.end();
+    mMutedTracks.invalidate();
+    mSlicedDuration += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+    if (mSlicedPlan->isFinished(mSlicedPosition)) {
+        auto* preset = mSlicedPreset;
+        mSlicedPreset = nullptr;
+        mSlicedPlan = nullptr;
+        onSlicedRecallFinished(preset);
+    }
+}
+
+/**
+ * Completion callback of a sliced recall
+ */
+void LivePresetsModel::onSlicedRecallFinished(LivePreset* preset) {
+    mActivePreset = preset;
+
+    RecallProfiler::Timer uiTimer(RecallProfiler::UI);
+    if (g_lpe->mController.mList)
+        g_lpe->mController.mList->invalidate();
+    uiTimer.stop();
+
+    //the undo point has to contain the layout
+    if (mDoUndo) {
+        applyLayoutValues();
+        Undo_OnStateChangeEx2(nullptr, "Recall LivePreset", UNDO_STATE_ALL, -1);
+    }
+
+    g_lpe->mProfiler.add(RecallProfiler::TOTAL, mSlicedDuration);
+    mIsStateChanged = false;
+    mStateChangeCount = GetProjectStateChangeCount(nullptr);
+}
+
+/**
+ * Queues a track value that only changes the layout
+ * @param key an interned key
+ */
+void LivePresetsModel::setLayoutValue(MediaTrack* track, const char* key, double value) {
+    mLayoutValues[{track, key}] = value;
+}
+
+/**
+ * Writes the queued layout values and adjusts the track list windows once when a value changed
+ */
+void LivePresetsModel::applyLayoutValues() {
+    bool isApplied = isActivePresetApplied();
+    bool isChanged = false;
+
+    RecallProfiler::Timer timer(RecallProfiler::UI);
+    mShadowState.begin(mIsShadowState);
+    PreventUIRefresh(1);
+    for (const auto& entry : mLayoutValues) {
+        //the track may have been removed since the recall
+        if (ValidatePtr2(nullptr, entry.first.first, "MediaTrack*"))
+            isChanged |= mShadowState.setTrackValue(entry.first.first, entry.first.second, entry.second);
+    }
+    mLayoutValues.clear();
+    if (isChanged) {
+        TrackList_AdjustWindows(true);
+        mMutedTracks.invalidate();
+    }
+    PreventUIRefresh(-1);
+    mShadowState.end();
+
+    //changes made by the recall itself don't count
+    if (isApplied) {
+        mIsStateChanged = false;
+        mStateChangeCount = GetProjectStateChangeCount(nullptr);
+    }
+}
+
+/**
+ * Stops a running sliced recall, the project stays partially recalled
+ */
+void LivePresetsModel::cancelSlicedRecall() {
+    if (!mSlicedPreset)
+        return;
+
+    mSlicedPreset = nullptr;
+    mSlicedPlan = nullptr;
+    mIsStateChanged = true;
+}
+
+/**
+ * True when nothing changed since the active preset was recalled
+ */
+bool LivePresetsModel::isActivePresetApplied() const {
+    return !mIsStateChanged && mStateChangeCount == GetProjectStateChangeCount(nullptr);
+}
+
+/**
+ * Called by ProjectChangeListener when the user changed tracks, sends or fxs
+ */
+void LivePresetsModel::onStateChanged() {
+    mIsStateChanged = true;
+}
+
+void LivePresetsModel::removeTransitions(const LivePreset* preset) {
+    if (preset == mSlicedPreset || preset == mActivePreset)
+        cancelSlicedRecall();
+
+    for (auto it = mTransitions.begin(); it != mTransitions.end();) {
+        if (it->first.first == preset || it->first.second == preset)
+            it = mTransitions.erase(it);
+        else
+            it++;
+    }
 }
 
 void LivePresetsModel::replacePreset(LivePreset *oldPreset, LivePreset *newPreset) {
+    removeTransitions(oldPreset);
+    if (oldPreset == mActivePreset)
+        mIsStateChanged = true;
     mPresets.erase(remove(mPresets.begin(), mPresets.end(), oldPreset), mPresets.end());
+    unindexPreset(oldPreset);
     mPresets.push_back(newPreset);
+    indexPreset(newPreset);
 }
 
 /**
@@ -184,7 +438,11 @@ void LivePresetsModel::replacePreset(LivePreset *oldPreset, LivePreset *newPrese
  */
 void LivePresetsModel::removePreset(LivePreset* preset, bool saveUndo) {
     mPresets.erase(remove(mPresets.begin(), mPresets.end(), preset), mPresets.end());
+    unindexPreset(preset);
     g_lpe->mActions.remove(preset->mRecallCmdId);
+    removeTransitions(preset);
+    if (preset == mActivePreset)
+        mIsStateChanged = true;
     if (saveUndo) {
         Undo_OnStateChangeEx2(nullptr, "Remove LivePreset", UNDO_STATE_MISCCFG, -1);
     }
@@ -197,7 +455,128 @@ void LivePresetsModel::removePresets(std::vector<LivePreset*>& presets) {
     Undo_OnStateChangeEx2(nullptr, "Remove src", UNDO_STATE_MISCCFG, -1);
 }
 
-void LivePresetsModel::persistHandler(WDL_FastString &str) const {
+/**
+ * Decodes the binary chunks of the presets and reads them like a text chunk. A chunk that can't be decoded is reported
+ * when the project is loaded and written back unchanged on every save, so saving never drops it
+ */
+void LivePresetsModel::loadEncodedChunks() {
+    auto chunks = std::move(mEncodedChunks);
+    mEncodedChunks.clear();
+    int failedCount = 0;
+    for (const auto& [version, base64] : chunks) {
+        std::string data;
+        std::string text;
+        if (version != ChunkCodec::VERSION || !ChunkCodec::decodeBase64(base64, data)
+                || !ChunkCodec::decode(data, text)) {
+            ChunkCodec::appendLines(version, base64, mUndecodedChunks);
+            failedCount++;
+            continue;
+        }
+
+        text += ">\n";
+        auto decoded = WDL_FastString();
+        decoded.Set(text.data(), (int) text.size());
+        auto ctx = StringProjectStateContext(decoded);
+        initFromChunk((ProjectStateContext*) &ctx);
+    }
+
+    //undo and redo load the same chunks again, the user is told once per project load
+    if (failedCount > 0 && !mPrevious) {
+        auto msg = "LPE - " + std::to_string(failedCount) + " binary preset chunk(s) of this project could not be "
+                "decoded, they may need a newer version of the extension. They are not loaded but kept unchanged when "
+                "the project is saved\n";
+        ShowConsoleMsg(msg.data());
+    }
+}
+
+/**
+ * Reads the guid of the element in chunk, lines of nested elements are skipped
+ */
+static bool ReadChunkGuid(std::string_view chunk, GUID& guid) {
+    int depth = 0;
+    size_t pos = 0;
+    while (pos < chunk.size()) {
+        auto end = std::min(chunk.find('\n', pos), chunk.size());
+        auto line = chunk.substr(pos, end - pos);
+        pos = end + 1;
+
+        if (line.starts_with('<')) {
+            depth++;
+        } else if (line == ">") {
+            depth--;
+        } else if (depth == 1 && line.starts_with("GUID ")) {
+            auto str = std::string(line.substr(5));
+            stringToGuid(str.data(), &guid);
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Loads a preset of an undo state. The preset of the previous model with the same guid is taken over when its chunk
+ * did not change, otherwise the preset is parsed and replaces it with the same recall action
+ */
+LivePreset* LivePresetsModel::reloadPreset(ProjectStateContext* ctx) {
+    static constexpr std::string_view HEADER = "<LIVEPRESET\n";
+
+    auto chunk = WDL_FastString();
+    chunk.Append(HEADER.data());
+    copyElement(ctx, chunk);
+    auto text = std::string_view(chunk.Get(), chunk.GetLength());
+
+    GUID guid{};
+    auto it = ReadChunkGuid(text, guid) ? mPrevious->mPresetsByGuid.find(guid) : mPrevious->mPresetsByGuid.end();
+    LivePreset* previous = nullptr;
+    if (it != mPrevious->mPresetsByGuid.end()) {
+        previous = it->second;
+        //every preset of the previous model is used at most once
+        mPrevious->mPresetsByGuid.erase(it);
+
+        if (previous->mChunkCache.isEqual(*previous, text, ChunkCache::getHash(text))) {
+            mTakenPresets.insert(previous);
+            if (previous == mPrevious->mActivePreset)
+                mActivePreset = previous;
+            return previous;
+        }
+    }
+
+    auto body = WDL_FastString();
+    body.Set(chunk.Get() + HEADER.size());
+    auto bodyCtx = StringProjectStateContext(body);
+    BaseCommand::CommandID recallCmdId = 0;
+    if (previous) {
+        //the new preset owns the action now, it is not removed with the previous preset
+        recallCmdId = previous->mRecallCmdId;
+        previous->mRecallCmdId = 0;
+    }
+    return new LivePreset((ProjectStateContext*) &bodyCtx, recallCmdId, mIsLazyLoad);
+}
+
+/**
+ * Deletes the presets of the previous model that were not taken over, presets that are not part of the loaded state
+ * anymore lose their recall action
+ */
+void LivePresetsModel::releasePrevious() {
+    if (!mPrevious)
+        return;
+
+    for (auto* preset : mPrevious->mPresets) {
+        if (mTakenPresets.contains(preset))
+            continue;
+        if (preset->mRecallCmdId != 0)
+            g_lpe->mActions.remove(preset->mRecallCmdId);
+        delete preset;
+    }
+    mPrevious->mPresets.clear();
+    mPrevious->mActivePreset = nullptr;
+    mPrevious->reset();
+
+    mPrevious = nullptr;
+    mTakenPresets.clear();
+}
+
+void LivePresetsModel::persistHandler(ChunkWriter &str) const {
     //add attributes
     str.AppendFormatted(4096, "VERSION %d\n", VERSION);
     str.AppendFormatted(4096, "UNDO %d\n", mDoUndo);
@@ -205,44 +584,82 @@ void LivePresetsModel::persistHandler(WDL_FastString &str) const {
     str.AppendFormatted(4096, "RESELECTPRESETS %d\n", mIsReselectLivePresetByValueRecall);
     str.AppendFormatted(4096, "RESELECTFXPRESETS %d\n", mIsReselectFxPreset);
     str.AppendFormatted(4096, "LOADMUTED %d\n", mIsLoadStateOnMute);
+    str.AppendFormatted(4096, "COMPILERECALL %d\n", mIsCompileRecall);
+    str.AppendFormatted(4096, "SHADOWSTATE %d\n", mIsShadowState);
+    str.AppendFormatted(4096, "LAZYLOAD %d\n", mIsLazyLoad);
+    str.AppendFormatted(4096, "BINARYCHUNK %d\n", mIsBinaryChunk);
+    str.AppendFormatted(4096, "RECALLSLICEBUDGET %d\n", mRecallSliceBudget);
     str.AppendFormatted(4096, "DEFAULTFILTER \"%s\"\n", mDefaultFilterPreset.data());
 
-    //add objects
+    //add objects, unchanged presets reuse the chunk of the last save
     for (const auto* preset : mPresets) {
-        preset->persist(str);
+        preset->persistCached(str, mIsBinaryChunk);
     }
 
     for (const auto* preset : mFilterPresets) {
-        preset->persist(str);
+        preset->persistCached(str, mIsBinaryChunk);
     }
 
+    if (!mUndecodedChunks.empty())
+        str.Append(mUndecodedChunks.c_str());
+
     for (auto* hardware : mHardwares) {
         Hardware_Persist(hardware, str);
     }
 }
 
 void LivePresetsModel::recallByValue(int val) {
-    for (auto* preset : mPresets) {
-        if (preset->mRecallId == val) {
-            if (mIsReselectLivePresetByValueRecall || !mActivePreset || preset != mActivePreset)
-                recallPreset(preset);
-            break;
-        }
-    }
+    auto* preset = mRecallIds.find(val);
+    if (preset && (mIsReselectLivePresetByValueRecall || !mActivePreset || preset != mActivePreset))
+        recallPreset(preset);
 }
 
 /**
  * Use this function to assign recallIds for presets instead of the preset itself to prevent non-unique IDs
  * @param preset the preset to assign the unique id to
- * @param id the unique id
+ * @param id the requested id, the next free id is used when it is taken
  */
 int LivePresetsModel::getRecallIdForPreset(LivePreset* preset, int id) {
-    for (auto* mPreset : mPresets) {
-        if ((mPreset->mRecallId == id && !GuidsEqual(preset->mGuid, mPreset->mGuid)) || id == -1) {
-            return getRecallIdForPreset(preset, id + 1);
-        }
+    return mRecallIds.getFreeId(preset, id);
+}
+
+/**
+ * Adds a preset of mPresets to the recall id table and the guid index
+ */
+void LivePresetsModel::indexPreset(LivePreset* preset) {
+    mRecallIds.insert(preset);
+    mPresetsByGuid.try_emplace(preset->mGuid, preset);
+}
+
+/**
+ * Removes a preset that left mPresets from the indices, a preset that shares its id or guid takes it over
+ */
+void LivePresetsModel::unindexPreset(const LivePreset* preset) {
+    bool isIdOwner = mRecallIds.find(preset->mRecallId) == preset;
+    mRecallIds.remove(preset);
+
+    auto it = mPresetsByGuid.find(preset->mGuid);
+    bool isGuidOwner = it != mPresetsByGuid.end() && it->second == preset;
+    if (isGuidOwner)
+        mPresetsByGuid.erase(it);
+
+    if (!isIdOwner && !isGuidOwner)
+        return;
+    for (auto* other : mPresets) {
+        if (isIdOwner && other->mRecallId == preset->mRecallId)
+            mRecallIds.insert(other);
+        if (isGuidOwner && GuidsEqual(other->mGuid, preset->mGuid))
+            mPresetsByGuid.try_emplace(other->mGuid, other);
+    }
+}
+
+void LivePresetsModel::rebuildIndices() {
+    mRecallIds.rebuild(mPresets);
+    mPresetsByGuid.clear();
+    mPresetsByGuid.reserve(mPresets.size());
+    for (auto* preset : mPresets) {
+        mPresetsByGuid.try_emplace(preset->mGuid, preset);
     }
-    return id;
 }
 
 /**
@@ -251,6 +668,7 @@ int LivePresetsModel::getRecallIdForPreset(LivePreset* preset, int id) {
  */
 void LivePresetsModel::onApplySelectedTrackConfigsToAllPresets(const std::vector<MediaTrack*>& tracks) {
     for (auto* preset : mPresets) {
+        preset->ensureLoaded();
         for (auto* updatingTrack : tracks) {
             auto guid = *GetTrackGUID(updatingTrack);
 
@@ -274,6 +692,7 @@ void LivePresetsModel::onApplySelectedTrackConfigsToAllPresets(const std::vector
 
             preset->mDate = time(nullptr);
         }
+        preset->invalidateRecallPlan();
     }
 }
 
@@ -295,4 +714,8 @@ void LivePresetsModel::reset() {
         delete preset;
     }
     mPresets.clear();
+    rebuildIndices();
+    cancelSlicedRecall();
+    mTransitions.clear();
+    mLayoutValues.clear();
 }
\ No newline at end of file
@@ -35,13 +35,19 @@
 #include <liblpe/data/models/base/Persistable.h>
 #include <liblpe/data/models/FilterPreset.h>
 #include <liblpe/data/models/Hardware.h>
+#include <liblpe/util/TrackIndex.h>
+#include <liblpe/util/FxIndex.h>
+#include <liblpe/util/ShadowState.h>
+#include <liblpe/util/RecallIdTable.h>
+#include <liblpe/util/MutedTracksCache.h>
+#include <unordered_set>
 
 class LivePresetsModel : public Persistable {
 public:
     static const int VERSION = 1;
 
     LivePresetsModel() = default;
-    explicit LivePresetsModel(ProjectStateContext* ctx);
+    explicit LivePresetsModel(ProjectStateContext* ctx, LivePresetsModel* previous = nullptr);
     LivePresetsModel& operator=(LivePresetsModel&& other) noexcept;
     ~LivePresetsModel();
 
@@ -50,11 +56,26 @@ public:
     bool mIsLoadStateOnMute = false;
     bool mIsReselectFxPreset = false;
     bool mIsReselectLivePresetByValueRecall = false;
+    bool mIsCompileRecall = false;
+    bool mIsShadowState = false;
+    //presets keep their track data as raw chunk until they are used
+    bool mIsLazyLoad = false;
+    //presets are written as base64 of ChunkCodec, about 40% smaller. Saving a changed preset and loading take about
+    //twice as long as with text, so it is opt-in
+    bool mIsBinaryChunk = false;
+    //time budget of a recall slice in us, 0 recalls the whole preset at once
+    int mRecallSliceBudget = 0;
     std::string mDefaultFilterPreset;
     std::vector<Hardware*> mHardwares;
     std::vector<LivePreset*> mPresets;
     std::vector<FilterPreset*> mFilterPresets;
 
+    //transient data
+    TrackIndex mTrackIndex;
+    FxIndex mFxIndex;
+    ShadowState mShadowState;
+    MutedTracksCache mMutedTracks;
+
     const LivePreset* getActivePreset();
     void recallByValue(int cc);
     int getRecallIdForPreset(LivePreset* preset, int id = 0);
@@ -65,16 +86,54 @@ public:
     void addPreset(LivePreset* preset, bool saveUndo = true);
     [[nodiscard]] LivePreset* getCurrentSettingsAsPreset() const;
     void removePresets(std::vector<LivePreset*> &preset);
-    void recallPreset(LivePreset* preset);
-    bool recallPresetByGuid(GUID guid);
+    void recallPreset(LivePreset* preset, bool allowSliced = true);
+    bool recallPresetByGuid(const GUID& guid);
     void onApplySelectedTrackConfigsToAllPresets(const std::vector<MediaTrack*>& tracks);
+    void onStateChanged();
+    void onRun();
+    void setLayoutValue(MediaTrack* track, const char* key, double value);
     void reset();
 protected:
-    void persistHandler(WDL_FastString &str) const override;
-    bool initFromChunkHandler(std::string &key, std::vector<const char *> &params) override;
-    bool initFromChunkHandler(std::string &key, ProjectStateContext *ctx) override;
+    void persistHandler(ChunkWriter &str) const override;
+    bool initFromChunkHandler(std::string_view key, std::vector<const char *> &params) override;
+    bool initFromChunkHandler(std::string_view key, ProjectStateContext *ctx) override;
 private:
     LivePreset* mActivePreset = nullptr;
+    RecallIdTable mRecallIds;
+    std::unordered_map<GUID, LivePreset*, GuidHash, GuidEqual> mPresetsByGuid;
+    //cached transitions from one preset to another, only used while the project still matches mActivePreset
+    std::map<std::pair<const LivePreset*, const LivePreset*>, RecallPlan> mTransitions;
+    bool mIsStateChanged = true;
+    int mStateChangeCount = -1;
+    //running sliced recall
+    LivePreset* mSlicedPreset = nullptr;
+    RecallPlan* mSlicedPlan = nullptr;
+    size_t mSlicedPosition = 0;
+    double mSlicedDuration = 0;
+    //layout track values of the last recall, applied on the next idle tick
+    std::map<std::pair<MediaTrack*, const char*>, double> mLayoutValues;
+    //version and base64 of the binary chunks read by initFromChunk, decoded after it
+    std::vector<std::pair<int, std::string>> mEncodedChunks;
+    //lines of binary chunks that could not be decoded, they are written back unchanged
+    std::string mUndecodedChunks;
+    //model of the state before an undo or redo, its unchanged presets are taken over while loading
+    LivePresetsModel* mPrevious = nullptr;
+    std::unordered_set<const LivePreset*> mTakenPresets;
+
+    void recallSettings(LivePreset* preset);
+    RecallPlan& getRecallPlan(LivePreset* preset);
+    void executeSlice();
+    void onSlicedRecallFinished(LivePreset* preset);
+    void applyLayoutValues();
+    void cancelSlicedRecall();
+    [[nodiscard]] bool isActivePresetApplied() const;
+    void removeTransitions(const LivePreset* preset);
+    void indexPreset(LivePreset* preset);
+    void unindexPreset(const LivePreset* preset);
+    void rebuildIndices();
+    void loadEncodedChunks();
+    LivePreset* reloadPreset(ProjectStateContext* ctx);
+    void releasePrevious();
     [[nodiscard]] std::string getChunkId() const override;
 };
 
@@ -28,20 +28,42 @@
 ******************************************************************************/
 
 #include <liblpe/data/models/CommandList.h>
+#include <algorithm>
 
 CommandList::~CommandList() {
-    for (auto pair : mCommands) {
-        delete pair.second;
+    for (auto& slot : mSlots) {
+        delete slot.command;
     }
-    mCommands.clear();
+    mSlots.clear();
+    mCount = 0;
 }
 
-BaseCommand* CommandList::find(const BaseCommand::CommandID id) const {
-    const auto it = mCommands.find(id);
-    return it != mCommands.end() ? it->second : nullptr;
+BaseCommand* CommandList::find(int id) const {
+    if (id < mMinId || id > mMaxId)
+        return nullptr;
+
+    size_t index = findSlot(id);
+    return mSlots[index].command;
+}
+
+/**
+ * @return the slot holding id or the empty slot where the probe sequence of id ends
+ */
+size_t CommandList::findSlot(int id) const {
+    size_t mask = mSlots.size() - 1;
+    //reaper hands out ids in ascending order, so the id itself spreads them well
+    size_t index = (size_t) id & mask;
+    while (mSlots[index].command && mSlots[index].id != id) {
+        index = (index + 1) & mask;
+    }
+    return index;
 }
 
-bool CommandList::run(BaseCommand::CommandID id, int val, int valhw, int relmode, HWND hwnd) const {
+bool CommandList::contains(int id) const {
+    return find(id) != nullptr;
+}
+
+bool CommandList::run(int id, int val, int valhw, int relmode, HWND hwnd) const {
     if (BaseCommand* command = find(id)) {
         command->run(val, valhw, relmode, hwnd);
         return true;
@@ -51,12 +73,49 @@ bool CommandList::run(BaseCommand::CommandID id, int val, int valhw, int relmode
 }
 
 BaseCommand::CommandID CommandList::add(BaseCommand *command) {
-    mCommands.emplace(command->id(), command);
+    if (find(command->id()))
+        return command->id();
+
+    if ((mCount + 1) * 2 > mSlots.size())
+        grow();
+    insert({command->id(), command});
+    mCount++;
+    mMinId = std::min(mMinId, (int) command->id());
+    mMaxId = std::max(mMaxId, (int) command->id());
     return command->id();
 }
 
 void CommandList::remove(BaseCommand::CommandID cmdId) {
     auto* command = find(cmdId);
-    mCommands.erase(cmdId);
+    if (!command)
+        return;
+
+    size_t mask = mSlots.size() - 1;
+    size_t hole = findSlot(cmdId);
+    mSlots[hole] = Slot();
+    mCount--;
+
+    //shift the following entries of the probe sequence back so no lookup stops at the hole
+    for (size_t index = (hole + 1) & mask; mSlots[index].command; index = (index + 1) & mask) {
+        size_t home = (size_t) mSlots[index].id & mask;
+        if (((index - home) & mask) >= ((index - hole) & mask)) {
+            mSlots[hole] = mSlots[index];
+            mSlots[index] = Slot();
+            hole = index;
+        }
+    }
     delete command;
+}
+
+void CommandList::insert(const Slot& slot) {
+    mSlots[findSlot(slot.id)] = slot;
+}
+
+void CommandList::grow() {
+    auto slots = std::move(mSlots);
+    mSlots = std::vector<Slot>(slots.empty() ? 16 : slots.size() * 2);
+    for (const auto& slot : slots) {
+        if (slot.command)
+            insert(slot);
+    }
 }
\ No newline at end of file
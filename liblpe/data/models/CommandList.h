@@ -32,18 +32,39 @@
 
 #include <liblpe/data/models/HotkeyCommand.h>
 #include <liblpe/data/models/ActionCommand.h>
-#include <map>
+#include <climits>
+#include <vector>
 
+/**
+ * Reaper passes every executed action to the command hooks, so lookups have to be cheap for ids that are not ours.
+ * Ids outside of the range of our commands are rejected by a single compare, the others are found in a flat open
+ * addressing table
+ */
 class CommandList {
 public:
     ~CommandList();
 
     BaseCommand::CommandID add(BaseCommand *command);
     void remove(BaseCommand::CommandID cmdId);
-    bool run(BaseCommand::CommandID id, int val = 0, int valhw = 0, int relmode = 0, HWND hwnd = nullptr) const;
+    [[nodiscard]] bool contains(int id) const;
+    bool run(int id, int val = 0, int valhw = 0, int relmode = 0, HWND hwnd = nullptr) const;
 private:
-    [[nodiscard]] BaseCommand* find(BaseCommand::CommandID id) const;
-    std::map<BaseCommand::CommandID, BaseCommand*> mCommands;
+    struct Slot {
+        int id = 0;
+        BaseCommand* command = nullptr;
+    };
+
+    //linear probing, the size is a power of two and at most half of the slots are used
+    std::vector<Slot> mSlots;
+    size_t mCount = 0;
+    //range of all ids ever added, it is not shrunk on remove
+    int mMinId = INT_MAX;
+    int mMaxId = INT_MIN;
+
+    [[nodiscard]] BaseCommand* find(int id) const;
+    [[nodiscard]] size_t findSlot(int id) const;
+    void insert(const Slot& slot);
+    void grow();
 };
 
 
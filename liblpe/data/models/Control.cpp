@@ -13,15 +13,15 @@ Control::Control(ProjectStateContext *ctx) {
     initFromChunk(ctx);
 }
 
-void Control::persistHandler(WDL_FastString &str) const {
+void Control::persistHandler(ChunkWriter &str) const {
 
 }
 
-bool Control::initFromChunkHandler(std::string &key, std::vector<const char *> &params) {
+bool Control::initFromChunkHandler(std::string_view key, std::vector<const char *> &params) {
     return false;
 }
 
-bool Control::initFromChunkHandler(std::string &key, ProjectStateContext *ctx) {
+bool Control::initFromChunkHandler(std::string_view key, ProjectStateContext *ctx) {
     return false;
 }
 
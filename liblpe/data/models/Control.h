@@ -20,9 +20,9 @@ public:
     std::unique_ptr<ActionCommand> command;
     const char *getName(int index) const;
 protected:
-    void persistHandler(WDL_FastString &str) const override;
-    bool initFromChunkHandler(std::string &key, std::vector<const char *> &params) override;
-    bool initFromChunkHandler(std::string &key, ProjectStateContext *ctx) override;
+    void persistHandler(ChunkWriter &str) const override;
+    bool initFromChunkHandler(std::string_view key, std::vector<const char *> &params) override;
+    bool initFromChunkHandler(std::string_view key, ProjectStateContext *ctx) override;
 private:
     mutable char mNameText[256] = "";
     [[nodiscard]] std::string getChunkId() const override;
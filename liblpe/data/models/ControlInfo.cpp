@@ -23,7 +23,7 @@ void ControlInfo::saveCurrentState(bool update) {
 
 }
 
-void ControlInfo::persistHandler(WDL_FastString &str) const {
+void ControlInfo::persistHandler(ChunkWriter &str) const {
     char dst[64];
     guidToString(&mTrackGuid, dst);
     str.AppendFormatted(4096, "TRACKGUID %s\n", dst);
@@ -40,7 +40,7 @@ void ControlInfo::persistHandler(WDL_FastString &str) const {
     str.AppendFormatted(4096, "INDEX %i\n", mParamIndex);
 }
 
-bool ControlInfo::initFromChunkHandler(std::string &key, std::vector<const char *> &params) {
+bool ControlInfo::initFromChunkHandler(std::string_view key, std::vector<const char *> &params) {
     if (key == "TRACKGUID") {
         stringToGuid(params[0], &mTrackGuid);
         return true;
@@ -58,14 +58,14 @@ bool ControlInfo::initFromChunkHandler(std::string &key, std::vector<const char
         return true;
     }
     if (key == "INDEX") {
-        mParamIndex = std::stoi(params[0]);
+        mParamIndex = ParseInt(params[0]);
         return true;
     }
 
     return false;
 }
 
-bool ControlInfo::initFromChunkHandler(std::string &key, ProjectStateContext *) {
+bool ControlInfo::initFromChunkHandler(std::string_view key, ProjectStateContext *) {
     return false;
 }
 
@@ -24,14 +24,14 @@ public:
     FilterPreset* extractFilterPreset() override;
     bool applyFilterPreset(FilterPreset *preset) override;
 protected:
-    void persistHandler(WDL_FastString &str) const override;
-    bool initFromChunkHandler(std::string &key, std::vector<const char *> &params) override;
-    bool initFromChunkHandler(std::string &key, ProjectStateContext *ctx) override;
+    void persistHandler(ChunkWriter &str) const override;
+    bool initFromChunkHandler(std::string_view key, std::vector<const char *> &params) override;
+    bool initFromChunkHandler(std::string_view key, ProjectStateContext *ctx) override;
 private:
     [[nodiscard]] std::string getChunkId() const override;
 };
 
-inline void ControlInfo_Persist(ControlInfo* info, WDL_FastString& str) {
+inline void ControlInfo_Persist(ControlInfo* info, ChunkWriter& str) {
     info->persist(str);
 }
 inline ControlInfo* ControlInfo_Create(Filterable* parent, ProjectStateContext* ctx) {
@@ -40,7 +40,7 @@ FilterPreset::FilterPreset(ProjectStateContext *ctx) {
     initFromChunk(ctx);
 }
 
-void FilterPreset::persistHandler(WDL_FastString &str) const {
+void FilterPreset::persistHandler(ChunkWriter &str) const {
     char dest[64];
     guidToString(&mId.guid, dest);
     str.AppendFormatted(4096, "ID \"%s\" \"%s\" %i \"%s\"\n", dest, mId.key.data(), mId.data, mId.name.data());
@@ -53,26 +53,26 @@ void FilterPreset::persistHandler(WDL_FastString &str) const {
     }
 }
 
-bool FilterPreset::initFromChunkHandler(std::string &key, std::vector<const char*> &params) {
+bool FilterPreset::initFromChunkHandler(std::string_view key, std::vector<const char*> &params) {
     if (key == "ID") {
         stringToGuid(params[0], &mId.guid);
         mId.key = params[1];
-        mId.data = std::stoi(params[2]);
+        mId.data = ParseInt(params[2]);
         mId.name = params[3];
         return true;
     }
     if (key == "FILTER") {
-        mFilter = (FilterMode) std::stoi(params[0]);
+        mFilter = (FilterMode) ParseInt(params[0]);
         return true;
     }
     if (key == "TYPE") {
-        mType = (TYPE) std::stoi(params[0]);
+        mType = (TYPE) ParseInt(params[0]);
         return true;
     }
     return false;
 }
 
-bool FilterPreset::initFromChunkHandler(std::string &key, ProjectStateContext *ctx) {
+bool FilterPreset::initFromChunkHandler(std::string_view key, ProjectStateContext *ctx) {
     if (key == "FILTERPRESET") {
         mChilds.push_back(new FilterPreset(ctx));
         return true;
@@ -84,6 +84,118 @@ std::string FilterPreset::getChunkId() const {
     return "FILTERPRESET";
 }
 
+void FilterPreset::persistCached(ChunkWriter &str, bool isEncoded) const {
+    if (isEncoded)
+        mChunkCache.persistEncoded(*this, str);
+    else
+        mChunkCache.persist(*this, str);
+}
+
+/**
+ * Order independent hash of the identifying values and all childs, names are not hashed
+ */
+size_t FilterPreset::getHash() const {
+    if (mIsHashed)
+        return mHash;
+
+    auto mix = [](size_t h) -> size_t {
+        //splitmix64 finalizer
+        uint64_t x = h + 0x9E3779B97F4A7C15ull;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+        return (size_t) (x ^ (x >> 31));
+    };
+
+    size_t hash = mix((size_t) mType);
+    hash = mix(hash ^ (size_t) mFilter);
+    hash = mix(hash ^ (size_t) mId.data);
+    hash = mix(hash ^ std::hash<std::string>()(mId.key));
+    hash = mix(hash ^ GuidHash()(mId.guid));
+
+    //the sum does not depend on the order of the childs
+    size_t childs = mChilds.size();
+    for (const auto* child : mChilds) {
+        childs += mix(child->getHash());
+    }
+    mHash = mix(hash ^ childs);
+    mIsHashed = true;
+    return mHash;
+}
+
+FilterPresetIndex::FilterPresetIndex(const std::vector<FilterPreset*>& presets) {
+    mPresets.reserve(presets.size());
+    mNext.reserve(presets.size());
+    mHeads.reserve(presets.size());
+    for (auto* preset : presets) {
+        add(preset);
+    }
+}
+
+void FilterPresetIndex::add(FilterPreset* preset) {
+    size_t index = mPresets.size();
+    mPresets.push_back(preset);
+    mNext.push_back(NONE);
+
+    Key key{preset->mType, preset->mId.guid, preset->mId.data, preset->mId.key};
+    auto [it, inserted] = mHeads.try_emplace(key, index, index);
+    if (!inserted) {
+        auto& [head, tail] = it->second;
+        if (head == NONE) {
+            head = index;
+        } else {
+            mNext[tail] = index;
+        }
+        tail = index;
+    }
+}
+
+bool FilterPresetIndex::apply(Filterable& target, TYPE type) {
+    return apply(target, Key{type, GUID{}, 0, {}});
+}
+
+bool FilterPresetIndex::apply(Filterable& target, TYPE type, const GUID& guid) {
+    return apply(target, Key{type, guid, 0, {}});
+}
+
+bool FilterPresetIndex::apply(Filterable& target, TYPE type, int data) {
+    return apply(target, Key{type, GUID{}, data, {}});
+}
+
+bool FilterPresetIndex::apply(Filterable& target, TYPE type, std::string_view key) {
+    return apply(target, Key{type, GUID{}, 0, key});
+}
+
+/**
+ * Applies the first unused preset with the given identity to target
+ * @return true if a preset was found and applied
+ */
+bool FilterPresetIndex::apply(Filterable& target, const Key& key) {
+    auto it = mHeads.find(key);
+    if (it == mHeads.end())
+        return false;
+
+    //consume the candidates in order until one is accepted, like the presets were matched before
+    auto& head = it->second.first;
+    while (head != NONE) {
+        auto* preset = mPresets[head];
+        head = mNext[head];
+        if (target.applyFilterPreset(preset))
+            return true;
+    }
+    return false;
+}
+
+size_t FilterPresetIndex::KeyHash::operator()(const Key& key) const noexcept {
+    size_t hash = std::hash<int>()(key.type);
+    hash = hash * 31 + std::hash<int>()(key.data);
+    hash = hash * 31 + std::hash<std::string_view>()(key.key);
+    return hash * 31 + GuidHash()(key.guid);
+}
+
+bool FilterPresetIndex::KeyEqual::operator()(const Key& a, const Key& b) const {
+    return a.type == b.type && a.data == b.data && a.key == b.key && GuidsEqual(a.guid, b.guid);
+}
+
 FilterPreset::~FilterPreset() {
     for (auto *child : mChilds) {
         delete child;
@@ -102,59 +214,50 @@ void FilterPreset_AddPreset(std::vector<FilterPreset*>& presets, FilterPreset* n
     presets.push_back(newPreset);
 }
 
-void FilterPreset_SortChilds(FilterPreset *a) {
-    bool (*compare)(FilterPreset*, FilterPreset*) = [](FilterPreset* a, FilterPreset* b) -> bool {
-        if (a->mId.data != b->mId.data) {
-            return a->mId.data >= b->mId.data;
-        }
-        if (!GuidsEqual(a->mId.guid, b->mId.guid)) {
-            char ag[256];
-            char bg[256];
-            guidToString(&a->mId.guid, ag);
-            guidToString(&b->mId.guid, bg);
-            std::string as = ag;
-            std::string bs = bg;
-            return as >= bs;
-        }
-        if (a->mId.key != b->mId.key) {
-            return a->mId.key >= b->mId.key;
-        }
-        if (a->mId.name != b->mId.name) {
-            return a->mId.name >= b->mId.name;
-        }
+/**
+ * Compares the identifying values of two presets without their childs, names are not compared
+ */
+static bool FilterPreset_IsNodeEqual(const FilterPreset *a, const FilterPreset *b) {
+    return a->mType == b->mType &&
+           a->mFilter == b->mFilter &&
+           a->mId.data == b->mId.data &&
+           a->mId.key == b->mId.key &&
+           GuidsEqual(a->mId.guid, b->mId.guid);
+}
 
-        return true;
-    };
+/**
+ * Two presets are equal when their values are equal and their childs are equal regardless of their order.
+ * Presets with different hashes are never equal, equal hashes are checked deeply to rule out collisions
+ */
+bool FilterPreset_IsEqual(const FilterPreset *a, const FilterPreset *b) {
+    if (a->getHash() != b->getHash() || a->mChilds.size() != b->mChilds.size() || !FilterPreset_IsNodeEqual(a, b))
+        return false;
 
-    std::sort(a->mChilds.begin(), a->mChilds.end(), compare);
-}
+    //sort childs by hash, equal childs have to be in the same run of equal hashes
+    auto byHash = [](const FilterPreset* x, const FilterPreset* y) { return x->getHash() < y->getHash(); };
+    auto as = std::vector<const FilterPreset*>(a->mChilds.begin(), a->mChilds.end());
+    auto bs = std::vector<const FilterPreset*>(b->mChilds.begin(), b->mChilds.end());
+    std::sort(as.begin(), as.end(), byHash);
+    std::sort(bs.begin(), bs.end(), byHash);
 
-bool FilterPreset_IsEqual(FilterPreset *a, FilterPreset *b) {
-    //check if FilterPreset is equal
-    if (a->mType == b->mType &&
-            a->mFilter == b->mFilter &&
-            a->mId.data == b->mId.data &&
-            a->mId.key == b->mId.key &&
-            GuidsEqual(a->mId.guid, b->mId.guid)
-        ) {
-        if (a->mChilds.empty() && b->mChilds.empty()) {
-            return true;
-        }
-        //check if childs are equal
-        FilterPreset_SortChilds(a);
-        FilterPreset_SortChilds(b);
-        for (auto *ac : a->mChilds) {
-            for (auto *bc : b->mChilds) {
-                if (FilterPreset_IsEqual(ac, bc)) {
-                    goto next;
-                }
-            }
-            return false;
-            next:;
+    for (size_t runStart = 0; runStart < as.size();) {
+        size_t runEnd = runStart;
+        while (runEnd < as.size() && as[runEnd]->getHash() == as[runStart]->getHash())
+            runEnd++;
+
+        //match every child of the run to an unmatched equal child, runs only contain more than one child on
+        //duplicates or collisions
+        for (size_t i = runStart; i < runEnd; i++) {
+            size_t j = i;
+            while (j < runEnd && !FilterPreset_IsEqual(as[i], bs[j]))
+                j++;
+            if (j == runEnd)
+                return false;
+            std::swap(bs[i], bs[j]);
         }
-        return true;
+        runStart = runEnd;
     }
-    return false;
+    return true;
 }
 
 std::vector<std::string*> FilterPreset_GetNames(const std::vector<FilterPreset*>& presets) {
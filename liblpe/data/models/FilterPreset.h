@@ -2,7 +2,10 @@
 #define LPE_FILTERPRESET_H
 
 #include <liblpe/data/models/base/Persistable.h>
+#include <liblpe/data/models/base/ChunkCache.h>
 #include <liblpe/data/models/base/Filterable.h>
+#include <string_view>
+#include <unordered_map>
 
 class FilterPreset final : public Persistable {
 public:
@@ -22,19 +25,65 @@ public:
     FilterMode mFilter = FilterMode::RECALLED;
     std::vector<FilterPreset*> mChilds;
 
+    [[nodiscard]] size_t getHash() const;
+    void persistCached(ChunkWriter &str, bool isEncoded = false) const;
+
 protected:
-    void persistHandler(WDL_FastString &str) const override;
-    bool initFromChunkHandler(std::string &key, std::vector<const char *> &params) override;
-    bool initFromChunkHandler(std::string &key, ProjectStateContext *ctx) override;
+    void persistHandler(ChunkWriter &str) const override;
+    bool initFromChunkHandler(std::string_view key, std::vector<const char *> &params) override;
+    bool initFromChunkHandler(std::string_view key, ProjectStateContext *ctx) override;
 private:
+    //structural hash of this preset and its childs, computed on first use as presets are not changed afterwards
+    mutable size_t mHash = 0;
+    mutable bool mIsHashed = false;
+    //never invalidated for the same reason
+    ChunkCache mChunkCache;
+
     [[nodiscard]] std::string getChunkId() const override;
 };
 
+/**
+ * Looks up filter presets by the identity of the item they were extracted from, so applying the childs of a filter
+ * preset is linear in the number of childs. Presets with the same identity are applied in order.
+ */
+class FilterPresetIndex {
+public:
+    explicit FilterPresetIndex(const std::vector<FilterPreset*>& presets = {});
+
+    void add(FilterPreset* preset);
+    bool apply(Filterable& target, TYPE type);
+    bool apply(Filterable& target, TYPE type, const GUID& guid);
+    bool apply(Filterable& target, TYPE type, int data);
+    bool apply(Filterable& target, TYPE type, std::string_view key);
+private:
+    struct Key {
+        TYPE type;
+        GUID guid;
+        int data;
+        std::string_view key;
+    };
+    struct KeyHash {
+        size_t operator()(const Key& key) const noexcept;
+    };
+    struct KeyEqual {
+        bool operator()(const Key& a, const Key& b) const;
+    };
+
+    static constexpr size_t NONE = SIZE_MAX;
+
+    std::vector<FilterPreset*> mPresets;
+    //next preset with the same identity
+    std::vector<size_t> mNext;
+    //first unused and last preset per identity
+    std::unordered_map<Key, std::pair<size_t, size_t>, KeyHash, KeyEqual> mHeads;
+
+    bool apply(Filterable& target, const Key& key);
+};
+
 void FilterPreset_AddPreset(std::vector<FilterPreset*>& presets, FilterPreset* newPreset);
 std::vector<std::string*> FilterPreset_GetNames(const std::vector<FilterPreset*>& presets);
 FilterPreset* FilterPreset_GetFilterByName(const std::vector<FilterPreset*>& presets, std::string* name);
-bool FilterPreset_IsEqual(FilterPreset *a, FilterPreset *b);
-void FilterPreset_SortChilds(FilterPreset *a);
+bool FilterPreset_IsEqual(const FilterPreset *a, const FilterPreset *b);
 
 
 #endif //LPE_FILTERPRESET_H
\ No newline at end of file
@@ -29,6 +29,7 @@
 
 #include <liblpe/data/models/FxInfo.h>
 #include <liblpe/data/models/FilterPreset.h>
+#include <liblpe/data/models/RecallPlan.h>
 #include <liblpe/util/util.h>
 #include <cfloat>
 #include <liblpe/LivePresetsExtension.h>
@@ -44,7 +45,8 @@ FxInfo::FxInfo(Filterable* parent, ProjectStateContext* ctx) : BaseInfo(parent)
 }
 
 void FxInfo::saveCurrentState(bool update) {
-    int index = getCurrentIndex();
+    MediaTrack* track = getTrack();
+    int index = getCurrentIndex(track);
     mIndex = Parameter<int>(this, "INDEX", index, update ? mIndex.mFilter : RECALLED);
 
     //dont save any more info is the Fx cannot be found
@@ -52,28 +54,26 @@ void FxInfo::saveCurrentState(bool update) {
         return;
 
     char buffer[256] = "";
-    TrackFX_GetFXName(getTrack(), index, buffer, sizeof(buffer));
+    TrackFX_GetFXName(track, index, buffer, sizeof(buffer));
     mName = buffer;
 
-    TrackFX_GetPreset(getTrack(), index, buffer, sizeof(buffer));
+    TrackFX_GetPreset(track, index, buffer, sizeof(buffer));
     mPresetName = Parameter<std::string>(this, "PRESETNAME", buffer, update ? mPresetName.mFilter : RECALLED);
 
-    mEnabled = Parameter<bool>(this, "ENABLED", TrackFX_GetEnabled(getTrack(), index), update ? mEnabled.mFilter : RECALLED);
+    mEnabled = Parameter<bool>(this, "ENABLED", TrackFX_GetEnabled(track, index), update ? mEnabled.mFilter : RECALLED);
 
     auto min = DBL_MIN;
     auto max = DBL_MAX;
 
-    for (int i = 0; i < TrackFX_GetNumParams(getTrack(), index); i++) {
-        auto filter = update ? (mParamInfo.keyExists(i) ? mParamInfo.at(i).mFilter : RECALLED) : RECALLED;
-        auto param = Parameter<double>(&mParamInfo, i, TrackFX_GetParam(getTrack(), index, i, &min, &max), filter);
-        mParamInfo.insert(i, param);
+    for (int i = 0; i < TrackFX_GetNumParams(track, index); i++) {
+        auto filter = update && mParamInfo.keyExists(i) ? mParamInfo.filterAt(i) : RECALLED;
+        mParamInfo.insert(i, TrackFX_GetParam(track, index, i, &min, &max), filter);
     }
 
     // JS Midi plugin for Program Change or Bank Change must always set param 4 to 0 to trigger a midi send
     if (strcmp(mName.c_str(), "JS: MIDI Program/Bank Switch on Load") == 0) {
-        auto filter = update ? (mParamInfo.keyExists(4) ? mParamInfo.at(4).mFilter : RECALLED) : RECALLED;
-        auto param = Parameter<double>(&mParamInfo, 4, 0, filter);
-        mParamInfo.insert(4, param);
+        auto filter = update && mParamInfo.keyExists(4) ? mParamInfo.filterAt(4) : RECALLED;
+        mParamInfo.insert(4, 0, filter);
     }
 }
 
@@ -82,48 +82,79 @@ void FxInfo::recallSettings() const {
     if (isFilteredInChain())
         return;
 
-    int index = getCurrentIndex();
-    //dont recall any more info is the Fx cannot be found
+    MediaTrack* track = getTrack();
+    int index = recallStructure(track);
     if (index == -1)
         return;
 
+    //recall parameters once
+    RecallProfiler::Timer timer(RecallProfiler::FX_PARAMETERS, mGuid, mName);
+    for (int i = 0; i < mParamInfo.indexCount(); i++) {
+        if (!mParamInfo.isFilteredInChain(i))
+            g_lpe->mModel->mShadowState.setFxParam(track, index, i, mParamInfo.valueAt(i));
+    }
+}
+
+/**
+ * Recalls position, enabled state and plugin preset of the fx
+ * @param track the track of the fx
+ * @return the current index when the parameters of the fx have to be recalled, else -1
+ */
+int FxInfo::recallStructure(MediaTrack* track) const {
+    RecallProfiler::Timer timer(RecallProfiler::FX_STRUCTURE, mGuid, mName);
+    int index = getCurrentIndex(track);
+    //dont recall any more info is the Fx cannot be found
+    if (index == -1)
+        return -1;
+
     if (!mIndex.isFilteredInChain() && index != mIndex.mValue) {
-        TrackFX_CopyToTrack(getTrack(), getCurrentIndex(), getTrack(), mIndex.mValue, true);
+        TrackFX_CopyToTrack(track, index, track, mIndex.mValue, true);
+        g_lpe->mModel->mShadowState.invalidateFxs(track);
         index = mIndex.mValue;
     }
 
-    if (!mEnabled.isFilteredInChain() && TrackFX_GetEnabled(getTrack(), index) != mEnabled.mValue)
-        TrackFX_SetEnabled(getTrack(), index, mEnabled.mValue);
-
-    auto min = DBL_MIN;
-    auto max = DBL_MAX;
+    if (!mEnabled.isFilteredInChain() && TrackFX_GetEnabled(track, index) != mEnabled.mValue)
+        TrackFX_SetEnabled(track, index, mEnabled.mValue);
 
     //FX Preset loading
     //has to be done every time as changes by the user on plugin presets is not tracked
     char name[256];
-    TrackFX_GetFXName(getTrack(), index, (char*) name, 256);
+    TrackFX_GetFXName(track, index, (char*) name, 256);
+
+    timer.stop();
 
     switch (g_lpe->mPrs.get(name)) {
         case PluginRecallStrategies::NONE:
             //don't do anything
             break;
         case PluginRecallStrategies::PRESET: {
+            RecallProfiler::Timer presetTimer(RecallProfiler::FX_PRESET, mGuid, mName);
             //load reaper preset
-            TrackFX_GetPreset(getTrack(), index, (char*) name, 256);
+            TrackFX_GetPreset(track, index, (char*) name, 256);
             if (!mPresetName.isFilteredInChain() && (g_lpe->mModel->mIsReselectFxPreset || name != mPresetName.mValue.data())) {
-                TrackFX_SetPreset(getTrack(), index, mPresetName.mValue.data());
-            }
-            break;
-        }
-        case PluginRecallStrategies::PARAMETERS: {
-            //recall parameters once
-            for (int i = 0; i < mParamInfo.size(); i++) {
-                auto currentValue = TrackFX_GetParam(getTrack(), index, i, &min, &max);
-                if (!mParamInfo.at(i).isFilteredInChain() && currentValue != mParamInfo.at(i).mValue)
-                    TrackFX_SetParam(getTrack(), index, i, mParamInfo.at(i).mValue);
+                TrackFX_SetPreset(track, index, mPresetName.mValue.data());
+                g_lpe->mModel->mShadowState.invalidateFxs(track);
             }
             break;
         }
+        case PluginRecallStrategies::PARAMETERS:
+            return index;
+    }
+    return -1;
+}
+
+/**
+ * Adds the fx and its unfiltered parameters to the plan
+ */
+void FxInfo::compileRecall(RecallPlan& plan) const {
+    if (isFilteredInChain())
+        return;
+
+    MediaTrack* track = getTrack();
+    int slot = plan.addFx(this, track);
+    for (int i = 0; i < mParamInfo.indexCount(); i++) {
+        if (!mParamInfo.isFilteredInChain(i))
+            plan.addFxParam(slot, track, i, mParamInfo.valueAt(i));
     }
 }
 
@@ -131,34 +162,21 @@ MediaTrack* FxInfo::getTrack() const {
     if (GuidsEqual(mTrackGuid, BaseTrackInfo::MASTER_GUID))
         return GetMasterTrack(nullptr);
 
-    for (int i = 0; i < CountTracks(nullptr); ++i) {
-        MediaTrack* track = GetTrack(nullptr, i);
-        if (GuidsEqual(mTrackGuid, *GetTrackGUID(track)))
-            return track;
-    }
-    return nullptr;
+    return GetTrackByGUID(mTrackGuid);
 }
 
 /*
  * Returns the current index of the fx guid. -1 when the fx was not found.
  */
 int FxInfo::getCurrentIndex() const {
-    //first check for Fx
-    for (int i = 0; i < TrackFX_GetCount(getTrack()); i++) {
-        if (GuidsEqual(*TrackFX_GetFXGUID(getTrack(), i), mGuid)) {
-            return i;
-        }
-    }
-    //then check for RecFx
-    for (int i = RECFX_INDEX_FACTOR; i < RECFX_INDEX_FACTOR + TrackFX_GetRecCount(getTrack()); i++) {
-        if (GuidsEqual(*TrackFX_GetFXGUID(getTrack(), i), mGuid)) {
-            return i;
-        }
-    }
-    return -1;
+    return getCurrentIndex(getTrack());
 }
 
-void FxInfo::persistHandler(WDL_FastString &str) const {
+int FxInfo::getCurrentIndex(MediaTrack* track) const {
+    return g_lpe->mModel->mFxIndex.find(track, mGuid);
+}
+
+void FxInfo::persistHandler(ChunkWriter &str) const {
     BaseInfo::persistHandler(str);
 
     char dest[64];
@@ -174,7 +192,7 @@ void FxInfo::persistHandler(WDL_FastString &str) const {
     str.AppendFormatted(4096, "PRESET \"%s\" %i\n", mPresetName.mValue.data(), mPresetName.mFilter);
 }
 
-bool FxInfo::initFromChunkHandler(std::string &key, std::vector<const char*> &params) {
+bool FxInfo::initFromChunkHandler(std::string_view key, std::vector<const char*> &params) {
     if (key == "TRACKGUID") {
         stringToGuid(params[0], &mTrackGuid);
         return true;
@@ -188,15 +206,15 @@ bool FxInfo::initFromChunkHandler(std::string &key, std::vector<const char*> &pa
         return true;
     }
     if (key == "ENABLED") {
-        mEnabled = Parameter<bool>(this, "ENABLED", std::stoi(params[0]), (FilterMode) std::stoi(params[1]));
+        mEnabled = Parameter<bool>(this, "ENABLED", ParseInt(params[0]), (FilterMode) ParseInt(params[1]));
         return true;
     }
     if (key == "INDEX") {
-        mIndex = Parameter<int>(this, "INDEX", std::stoi(params[0]), (FilterMode) std::stoi(params[1]));
+        mIndex = Parameter<int>(this, "INDEX", ParseInt(params[0]), (FilterMode) ParseInt(params[1]));
         return true;
     }
     if (key == "PRESET") {
-        mPresetName = Parameter<std::string>(this, "PRESET", params[0], (FilterMode) std::stoi(params[1]));
+        mPresetName = Parameter<std::string>(this, "PRESET", params[0], (FilterMode) ParseInt(params[1]));
         return true;
     }
 
@@ -205,7 +223,8 @@ bool FxInfo::initFromChunkHandler(std::string &key, std::vector<const char*> &pa
 
 std::set<std::string> FxInfo::getKeys() const {
     auto set = BaseInfo::getKeys();
-    for (int i = 0; i < TrackFX_GetNumParams(getTrack(), getCurrentIndex()); i++) {
+    MediaTrack* track = getTrack();
+    for (int i = 0; i < TrackFX_GetNumParams(track, getCurrentIndex(track)); i++) {
         set.insert(std::to_string(i));
     }
     return set;
@@ -240,21 +259,11 @@ bool FxInfo::applyFilterPreset(FilterPreset *preset) {
     if (preset->mType == FX && GuidsEqual(preset->mId.guid, mGuid)) {
         mFilter = preset->mFilter;
 
-        auto toFilters = std::set<Filterable*>();
-        toFilters.insert(&mParamInfo);
-        toFilters.insert(&mEnabled);
-        toFilters.insert(&mIndex);
-        toFilters.insert(&mPresetName);
-
-        for (auto *child : preset->mChilds) {
-            for (auto *toFilter : toFilters) {
-                if (toFilter->applyFilterPreset(child)) {
-                    toFilters.erase(toFilter);
-                    goto cnt;
-                }
-            }
-            cnt:;
-        }
+        auto index = FilterPresetIndex(preset->mChilds);
+        index.apply(mParamInfo, PARAMS);
+        index.apply(mEnabled, PARAM, mEnabled.mKey);
+        index.apply(mIndex, PARAM, mIndex.mKey);
+        index.apply(mPresetName, PARAM, mPresetName.mKey);
         return true;
     }
     return false;
@@ -31,6 +31,7 @@
 #define LPE_FXINFO_H
 
 #include <liblpe/data/models/base/BaseInfo.h>
+#include <liblpe/data/models/Models.fwd.h>
 
 class FxInfo final : public BaseInfo {
 public:
@@ -51,16 +52,19 @@ public:
 
     [[nodiscard]] char *getTreeText() const override;
     void recallSettings() const override;
+    int recallStructure(MediaTrack* track) const;
+    void compileRecall(RecallPlan& plan) const;
     void saveCurrentState(bool update) override;
     FilterPreset* extractFilterPreset() override;
     bool applyFilterPreset(FilterPreset *preset) override;
 protected:
     [[nodiscard]] std::set<std::string> getKeys() const override;
-    void persistHandler(WDL_FastString &str) const override;
-    bool initFromChunkHandler(std::string &key, std::vector<const char*> &params) override;
+    void persistHandler(ChunkWriter &str) const override;
+    bool initFromChunkHandler(std::string_view key, std::vector<const char*> &params) override;
 private:
     [[nodiscard]] std::string getChunkId() const override;
     [[nodiscard]] int getCurrentIndex() const;
+    [[nodiscard]] int getCurrentIndex(MediaTrack* track) const;
     [[nodiscard]] MediaTrack* getTrack() const;
 };
 
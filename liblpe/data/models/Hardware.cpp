@@ -23,7 +23,7 @@ Hardware::~Hardware() {
     mControlInfos.clear();
 }
 
-void Hardware::persistHandler(WDL_FastString &str) const {
+void Hardware::persistHandler(ChunkWriter &str) const {
     str.AppendFormatted(4096, "NAME \"%s\"\n", mName.data());
 
     char dest[64];
@@ -35,7 +35,7 @@ void Hardware::persistHandler(WDL_FastString &str) const {
     }
 }
 
-bool Hardware::initFromChunkHandler(std::string &key, std::vector<const char *> &params) {
+bool Hardware::initFromChunkHandler(std::string_view key, std::vector<const char *> &params) {
     if (key == "GUID") {
         stringToGuid(params[0], &mGuid);
         return true;
@@ -49,7 +49,7 @@ bool Hardware::initFromChunkHandler(std::string &key, std::vector<const char *>
     return false;
 }
 
-bool Hardware::initFromChunkHandler(std::string &key, ProjectStateContext *ctx) {
+bool Hardware::initFromChunkHandler(std::string_view key, ProjectStateContext *ctx) {
     if (key == "CONTROL") {
         mControls.emplace_back(new Control(ctx));
         return true;
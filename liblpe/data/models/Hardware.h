@@ -30,13 +30,13 @@ public:
 private:
     std::vector<std::shared_ptr<ControlInfo>> mControlInfos;
 
-    void persistHandler(WDL_FastString &str) const override;
-    bool initFromChunkHandler(std::string &key, std::vector<const char *> &params) override;
-    bool initFromChunkHandler(std::string &key, ProjectStateContext *ctx) override;
+    void persistHandler(ChunkWriter &str) const override;
+    bool initFromChunkHandler(std::string_view key, std::vector<const char *> &params) override;
+    bool initFromChunkHandler(std::string_view key, ProjectStateContext *ctx) override;
     [[nodiscard]] std::string getChunkId() const override;
 };
 
-inline void Hardware_Persist(Hardware* hw, WDL_FastString& str) {
+inline void Hardware_Persist(Hardware* hw, ChunkWriter& str) {
     hw->persist(str);
 }
 inline Hardware* Hardware_Create(ProjectStateContext* ctx) {
@@ -32,6 +32,7 @@
 #include <reaper_plugin_functions.h>
 #include <liblpe/data/models/FilterPreset.h>
 #include <liblpe/util/util.h>
+#include <liblpe/LivePresetsExtension.h>
 
 /**
  * Create a new SendInfo object from a track
@@ -59,11 +60,7 @@ void HwSendInfo::saveCurrentState(bool update) {
     BaseSendInfo::saveCurrentState(update);
 
     //get track settings
-    for (const auto& key : getKeys()) {
-        FilterMode filter = update ? mParamInfo.at(key).mFilter : RECALLED;
-        auto param = Parameter<double>(&mParamInfo, key, GetTrackSendInfo_Value(getSrcTrack(), 1, mSendIdx, key.data()), filter);
-        mParamInfo.insert(key, param);
-    }
+    saveSendState(1, update);
 }
 
 void HwSendInfo::recallSettings() const {
@@ -74,17 +71,14 @@ void HwSendInfo::recallSettings() const {
     if (mSendIdx < 0)
         mSendIdx = CreateTrackSend(tr, nullptr);
 
-    for (const auto& key : getKeys()) {
-        if (GetTrackSendInfo_Value(tr, 1, mSendIdx, key.data()) != mParamInfo.at(key).mValue)
-            SetTrackSendInfo_Value(tr, 1, mSendIdx, key.data(), mParamInfo.at(key).mValue);
-    }
+    recallSendState(tr, 1);
 }
 
-bool HwSendInfo::initFromChunkHandler(std::string &key, std::vector<const char *> &params) {
+bool HwSendInfo::initFromChunkHandler(std::string_view key, std::vector<const char *> &params) {
     return BaseSendInfo::initFromChunkHandler(key, params);
 }
 
-void HwSendInfo::persistHandler(WDL_FastString &str) const {
+void HwSendInfo::persistHandler(ChunkWriter &str) const {
     BaseSendInfo::persistHandler(str);
 }
 
@@ -96,29 +90,14 @@ MediaTrack* HwSendInfo::getSrcTrack() const {
     if (GuidsEqual(mSrcTrackGuid, BaseTrackInfo::MASTER_GUID))
         return GetMasterTrack(nullptr);
 
-    for (int i = 0; i < CountTracks(nullptr); ++i)
-    {
-        MediaTrack* track = GetTrack(nullptr, i);
-        if (GuidsEqual(mSrcTrackGuid, *GetTrackGUID(track)))
-            return track;
-    }
-    return nullptr;
-}
-
-std::set<std::string> HwSendInfo::getKeys() const {
-    auto set = BaseSendInfo::getKeys();
-    std::set<std::string> keys = {
-
-    };
-    set.insert(keys.begin(), keys.end());
-    return set;
+    return GetTrackByGUID(mSrcTrackGuid);
 }
 
 char * HwSendInfo::getTreeText() const {
     mName.clear();
     mName.append("Send from ");
 
-    int src = (int) mParamInfo.at(I_SRCCHAN).mValue;
+    int src = (int) mParamInfo.valueAt(SendParam::SRCCHAN);
 
     int srcChStart;
     int srcChCount;
@@ -152,7 +131,7 @@ char * HwSendInfo::getTreeText() const {
         mName.append(std::to_string(srcChStart) + "-" + std::to_string(srcChStart + srcChCount - 1));
     }
 
-    int dst = (int) mParamInfo.at(I_DSTCHAN).mValue;
+    int dst = (int) mParamInfo.valueAt(SendParam::DSTCHAN);
 
     int dstChStrt;
     int dstChCnt;
@@ -193,7 +172,7 @@ std::string HwSendInfo::getChunkId() const {
 
 FilterPreset* HwSendInfo::extractFilterPreset() {
     FilterPreset::ItemIdentifier id{};
-    id.data = mParamInfo.at(I_DSTCHAN).mValue;
+    id.data = mParamInfo.valueAt(SendParam::DSTCHAN);
 
     auto childs = std::vector<FilterPreset*>();
     childs.push_back(mParamInfo.extractFilterPreset());
@@ -202,7 +181,7 @@ FilterPreset* HwSendInfo::extractFilterPreset() {
 }
 
 bool HwSendInfo::applyFilterPreset(FilterPreset *preset) {
-    if (preset->mType == SEND && preset->mId.data == mParamInfo.at(I_DSTCHAN).mValue) {
+    if (preset->mType == SEND && preset->mId.data == mParamInfo.valueAt(SendParam::DSTCHAN)) {
         mFilter = preset->mFilter;
         for (auto& child : preset->mChilds) {
             if (mParamInfo.applyFilterPreset(child)) {
@@ -47,9 +47,8 @@ public:
     FilterPreset* extractFilterPreset() override;
     bool applyFilterPreset(FilterPreset *preset) override;
 protected:
-    [[nodiscard]] std::set<std::string> getKeys() const override;
-    void persistHandler(WDL_FastString &str) const override;
-    bool initFromChunkHandler(std::string &key, std::vector<const char *> &params) override;
+    void persistHandler(ChunkWriter &str) const override;
+    bool initFromChunkHandler(std::string_view key, std::vector<const char *> &params) override;
     [[nodiscard]] MediaTrack *getSrcTrack() const override;
 private:
     [[nodiscard]] std::string getChunkId() const override;
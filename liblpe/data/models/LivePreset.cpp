@@ -30,12 +30,14 @@
 #include <liblpe/data/models/LivePreset.h>
 #include <liblpe/util/util.h>
 #include <liblpe/data/models/FilterPreset.h>
+#include <liblpe/data/models/StringProjectStateContext.h>
 #include <liblpe/LivePresetsExtension.h>
 #include <functional>
 
 LivePreset::LivePreset(std::string name, std::string description) : BaseInfo(nullptr), mName(std::move(name)),
-        mDescription(std::move(description)), mRecallId(g_lpe->mModel->getRecallIdForPreset(this)) {
+        mDescription(std::move(description)) {
     genGuid(&mGuid);
+    mRecallId = g_lpe->mModel->getRecallIdForPreset(this);
     LivePreset::saveCurrentState(false);
 
     if (mRecallCmdId == 0) {
@@ -43,8 +45,8 @@ LivePreset::LivePreset(std::string name, std::string description) : BaseInfo(nul
     }
 }
 
-LivePreset::LivePreset(ProjectStateContext *ctx, BaseCommand::CommandID recallCmdId) : BaseInfo(nullptr),
-        mRecallCmdId(recallCmdId) {
+LivePreset::LivePreset(ProjectStateContext *ctx, BaseCommand::CommandID recallCmdId, bool isLazy) : BaseInfo(nullptr),
+        mRecallCmdId(recallCmdId), mIsLazy(isLazy) {
     initFromChunk(ctx);
 
     if (mRecallCmdId == 0) {
@@ -78,6 +80,9 @@ LivePreset& LivePreset::operator=(LivePreset&& other) noexcept {
     mTracks = other.mTracks;
     mControlInfos = other.mControlInfos;
     mRecallCmdId = other.mRecallCmdId;
+    mIsLazy = other.mIsLazy;
+    mLazyBody.Set(other.mLazyBody.Get());
+    invalidateRecallPlan();
 
     //make all pointers null and create empty containers for now empty instance other that its destruction does not
     //affect this instance
@@ -85,15 +90,39 @@ LivePreset& LivePreset::operator=(LivePreset&& other) noexcept {
     mControlInfos = std::vector<std::shared_ptr<ControlInfo>>();
     mMasterTrack = nullptr;
     mRecallCmdId = 0;
+    other.mIsLazy = false;
+    other.mLazyBody.Set("");
+    other.mChunkCache.invalidate();
 
     return *this;
 }
 
+/**
+ * Loads the tracks and controls of a lazily loaded preset from its raw chunk
+ */
+void LivePreset::ensureLoaded() const {
+    if (!mIsLazy)
+        return;
+
+    //loading does not change the content of the preset, only its representation
+    auto *self = const_cast<LivePreset*>(this);
+    self->mIsLazy = false;
+    self->mLazyBody.Append(">\n");
+    auto ctx = StringProjectStateContext(mLazyBody);
+    self->initFromChunk((ProjectStateContext*) &ctx);
+    self->mLazyBody.Set("");
+    self->invalidateRecallPlan();
+}
+
 /**
  * Saves the current state as a preset
  * @param update true when a presets get updated, false when it is new
  */
 void LivePreset::saveCurrentState(bool update) {
+    ensureLoaded();
+    mRecallPlan.invalidate();
+    mChunkCache.invalidate();
+
     if (update) {
         mDate = time(nullptr);
 
@@ -103,43 +132,17 @@ void LivePreset::saveCurrentState(bool update) {
         //TODO update assignments
 
         //Normal tracks
-        auto savedTracks = std::vector<TrackInfo*>(mTracks);
-        auto currentTracks = std::vector<const GUID*>();
+        auto currentTracks = std::vector<MediaTrack*>();
         for (int i = 0; i < GetNumTracks(); i++) {
-            currentTracks.push_back(GetTrackGUID(GetTrack(nullptr, i)));
+            currentTracks.push_back(GetTrack(nullptr, i));
         }
 
-        auto tracksDelete = std::vector<TrackInfo*>();
-        auto tracksNew = std::vector<const GUID*>();
-        auto tracksUpdated = std::vector<std::pair<TrackInfo*, const GUID*>>();
-
-        //tracksUpdate are all tracks that remain after tracksDelete are removed from mTracks
-        // and before tracksNew are added
-        bool (*cmp)(TrackInfo*&, const GUID*&) = [](TrackInfo*& a, const GUID*& b) -> bool {
-            return GuidsEqual(a->mGuid, *b);
-        };
-
-        compareVectors(savedTracks, currentTracks, tracksDelete, tracksNew, tracksUpdated, *cmp);
-
-        for (auto& trackUpdate : tracksUpdated) {
-            trackUpdate.first->saveCurrentState(update);
-        }
-
-        for (TrackInfo* trackDelete : tracksDelete) {
-            int index = 0;
-            for (int i = 0; i < (int) mTracks.size(); i++) {
-                if (mTracks[i] == trackDelete) {
-                    index = i;
-                    break;
-                }
-            }
-            mTracks.erase(mTracks.begin() + index);
-        }
-
-        for (const GUID* trackNew : tracksNew) {
-            auto* info = new TrackInfo(nullptr, GetTrackByGUID(*trackNew));
-            mTracks.push_back(info);
-        }
+        //saved tracks that are no longer in the project are removed, new tracks are added
+        reconcile<GUID, GuidHash, GuidEqual>(mTracks, currentTracks,
+                [](TrackInfo* a) -> const GUID& { return a->mGuid; },
+                [](MediaTrack* b) -> const GUID& { return *GetTrackGUID(b); },
+                [update](TrackInfo* a, MediaTrack*) { a->saveCurrentState(update); },
+                [this](MediaTrack* b) { mTracks.push_back(new TrackInfo(nullptr, b)); });
 
     } else {
         mMasterTrack = new MasterTrackInfo(nullptr);
@@ -165,19 +168,15 @@ void LivePreset::createRecallAction() {
     auto desc = WDL_FastString();
     desc.AppendFormatted(4096, "LPE - Recall preset: %s", mName.data());
 
-    using namespace std::placeholders;
-    //transcode guid as 4 int to make it fit to the ActionCommand function
-    int ints[4];
-    GuidToInts(mGuid, ints);
-
+    //the guid is bound by value, the action recalls the preset of the project that is active when it runs
     mRecallCmdId = g_lpe->mActions.add(new ActionCommand(
             name.Get(),
             desc.Get(),
-            std::bind(&LPE::recallPresetByGuid, g_lpe.get(), ints[0], ints[1], ints[2], ints[3])
+            std::bind(&LPE::recallPresetByGuid, g_lpe.get(), mGuid)
     ));
 }
 
-void LivePreset::persistHandler(WDL_FastString& str) const {
+void LivePreset::persistHandler(ChunkWriter& str) const {
     BaseInfo::persistHandler(str);
 
     char dest[64];
@@ -189,6 +188,12 @@ void LivePreset::persistHandler(WDL_FastString& str) const {
     str.AppendFormatted(4096, "DATE %li\n", mDate);
     str.AppendFormatted(4096, "RECALLID %i\n", mRecallId);
 
+    //a preset that was never used is written back unchanged
+    if (mIsLazy) {
+        str.Append(mLazyBody.Get());
+        return;
+    }
+
     mMasterTrack->persist(str);
 
     for (auto *const track : mTracks) {
@@ -200,7 +205,7 @@ void LivePreset::persistHandler(WDL_FastString& str) const {
     }
 }
 
-bool LivePreset::initFromChunkHandler(std::string &key, std::vector<const char *> &params) {
+bool LivePreset::initFromChunkHandler(std::string_view key, std::vector<const char *> &params) {
     if (BaseInfo::initFromChunkHandler(key, params))
         return true;
 
@@ -217,17 +222,21 @@ bool LivePreset::initFromChunkHandler(std::string &key, std::vector<const char *
         return true;
     }
     if (key == "DATE") {
-        mDate = std::stoi(params[0]);
+        mDate = ParseInt(params[0]);
         return true;
     }
     if (key == "RECALLID") {
-        mRecallId = std::stoi(params[0]);
+        mRecallId = ParseInt(params[0]);
         return true;
     }
     return false;
 }
 
-bool LivePreset::initFromChunkHandler(std::string &key, ProjectStateContext *ctx) {
+bool LivePreset::initFromChunkHandler(std::string_view key, ProjectStateContext *ctx) {
+    if (mIsLazy && (key == "MASTERTRACKINFO" || key == "TRACKINFO" || key == "CONTROLINFO")) {
+        captureElement(key, ctx);
+        return true;
+    }
     if (key == "MASTERTRACKINFO") {
         mMasterTrack = new MasterTrackInfo(nullptr, ctx);
         return true;
@@ -246,9 +255,29 @@ bool LivePreset::initFromChunkHandler(std::string &key, ProjectStateContext *ctx
     return BaseInfo::initFromChunkHandler(key, ctx);
 }
 
+/**
+ * Copies a sub element up to its matching '>' into the raw chunk of the preset
+ */
+void LivePreset::captureElement(std::string_view key, ProjectStateContext *ctx) {
+    mLazyBody.AppendFormatted(4096, "<%.*s\n", (int) key.size(), key.data());
+    copyElement(ctx, mLazyBody);
+}
+
 void LivePreset::recallSettings() const {
-    mMasterTrack->recallSettings();
+    ensureLoaded();
+    if (g_lpe->mModel->mIsCompileRecall) {
+        if (!mRecallPlan.isValid())
+            mRecallPlan.compile(this);
+        mRecallPlan.execute();
+        return;
+    }
+
+    {
+        RecallProfiler::Timer timer(RecallProfiler::MASTERTRACK);
+        mMasterTrack->recallSettings();
+    }
     for (auto *const track : mTracks) {
+        RecallProfiler::Timer timer(RecallProfiler::TRACK, track->mGuid, track->mName.mValue);
         track->recallSettings();
     }
     for (const auto& info : mControlInfos) {
@@ -256,6 +285,36 @@ void LivePreset::recallSettings() const {
     }
 }
 
+/**
+ * Has to be called when tracks or filters of the preset are changed from outside
+ */
+void LivePreset::invalidateRecallPlan() {
+    mRecallPlan.invalidate();
+    mChunkCache.invalidate();
+    invalidateFilters();
+}
+
+/**
+ * Returns the compiled plan of this preset, compiles it first when it is outdated
+ */
+RecallPlan& LivePreset::getRecallPlan() const {
+    ensureLoaded();
+    if (!mRecallPlan.isValid())
+        mRecallPlan.compile(this);
+    return mRecallPlan;
+}
+
+/**
+ * Persists the preset like persist() but reuses the chunk of the last save when the preset did not change since
+ * @param isEncoded writes the chunk as binary ChunkCodec lines
+ */
+void LivePreset::persistCached(ChunkWriter &str, bool isEncoded) const {
+    if (isEncoded)
+        mChunkCache.persistEncoded(*this, str);
+    else
+        mChunkCache.persist(*this, str);
+}
+
 std::set<std::string> LivePreset::getKeys() const {
     return BaseInfo::getKeys();
 }
@@ -272,6 +331,7 @@ std::string LivePreset::getChunkId() const {
 }
 
 FilterPreset* LivePreset::extractFilterPreset() {
+    ensureLoaded();
     FilterPreset::ItemIdentifier id{};
     id.guid = mGuid;
 
@@ -292,28 +352,21 @@ FilterPreset* LivePreset::extractFilterPreset() {
 
 bool LivePreset::applyFilterPreset(FilterPreset *preset) {
     if (preset->mType == LIVEPRESET) {
+        ensureLoaded();
         mFilter = preset->mFilter;
+        mRecallPlan.invalidate();
+        mChunkCache.invalidate();
 
-        auto toFilters = std::set<Filterable*>();
-        toFilters.insert(mMasterTrack);
-        toFilters.insert(mTracks.begin(), mTracks.end());
-
-        //convert shared_ptr to raw pointer
-        auto temp = std::vector<ControlInfo*>();
-        for (const auto& ctrl : mControlInfos) {
-            temp.push_back(ctrl.get());
+        auto index = FilterPresetIndex(preset->mChilds);
+        index.apply(*mMasterTrack, MASTERTRACK);
+        for (auto *track : mTracks) {
+            index.apply(*track, TRACK, track->mGuid);
         }
-        toFilters.insert(temp.begin(), temp.end());
-
-        for (auto& child : preset->mChilds) {
-            for (auto *toFilter : toFilters) {
-                if (toFilter->applyFilterPreset(child)) {
-                    toFilters.erase(toFilter);
-                    goto cnt;
-                }
-            }
-            cnt:;
+        for (const auto& ctrl : mControlInfos) {
+            index.apply(*ctrl, CTRL, ctrl->mCtrlGuid);
         }
+        //filters of existing children changed
+        invalidateFilters();
         return true;
     }
     return false;
@@ -38,17 +38,21 @@
 #include <liblpe/data/models/MasterTrackInfo.h>
 #include <liblpe/data/models/base/BaseCommand.h>
 #include <liblpe/data/models/ControlInfo.h>
+#include <liblpe/data/models/RecallPlan.h>
+#include <liblpe/data/models/base/ChunkCache.h>
 
 class LivePreset final : public BaseInfo {
 public:
 	explicit LivePreset(std::string name = "New preset", std::string description = "");
-    explicit LivePreset(ProjectStateContext* ctx, BaseCommand::CommandID recallCmdId = 0);
+    explicit LivePreset(ProjectStateContext* ctx, BaseCommand::CommandID recallCmdId = 0, bool isLazy = false);
     LivePreset& operator=(LivePreset&& other) noexcept;
     ~LivePreset();
 
     //transient data
     BaseCommand::CommandID mRecallCmdId = 0;
     std::string mRecallIdDisplayingString = "";
+    mutable RecallPlan mRecallPlan;
+    ChunkCache mChunkCache;
 
     //data to persist
     GUID mGuid = GUID();
@@ -68,12 +72,21 @@ public:
     FilterPreset* extractFilterPreset() override;
     bool applyFilterPreset(FilterPreset *preset) override;
     void createRecallAction();
+    void invalidateRecallPlan();
+    [[nodiscard]] RecallPlan& getRecallPlan() const;
+    void ensureLoaded() const;
+    void persistCached(ChunkWriter &str, bool isEncoded = false) const;
 protected:
     [[nodiscard]] std::set<std::string> getKeys() const override;
-    void persistHandler(WDL_FastString &str) const override;
-    bool initFromChunkHandler(std::string &key, std::vector<const char *> &params) override;
-    bool initFromChunkHandler(std::string &key, ProjectStateContext *ctx) override;
+    void persistHandler(ChunkWriter &str) const override;
+    bool initFromChunkHandler(std::string_view key, std::vector<const char *> &params) override;
+    bool initFromChunkHandler(std::string_view key, ProjectStateContext *ctx) override;
 private:
+    //raw chunk of the tracks and controls while they are not loaded yet
+    bool mIsLazy = false;
+    WDL_FastString mLazyBody;
+
+    void captureElement(std::string_view key, ProjectStateContext *ctx);
     [[nodiscard]] std::string getChunkId() const override;
 };
 
@@ -31,11 +31,12 @@
 #include <reaper_plugin_functions.h>
 #include <liblpe/data/models/FilterPreset.h>
 
-MasterTrackInfo::MasterTrackInfo(Filterable* parent) : BaseTrackInfo(parent) {
+MasterTrackInfo::MasterTrackInfo(Filterable* parent) : BaseTrackInfo(parent, MASTER_PARAM_COUNT) {
     MasterTrackInfo::saveCurrentState(false);
 }
 
-MasterTrackInfo::MasterTrackInfo(Filterable* parent, ProjectStateContext* ctx) : BaseTrackInfo(parent) {
+MasterTrackInfo::MasterTrackInfo(Filterable* parent, ProjectStateContext* ctx) :
+        BaseTrackInfo(parent, MASTER_PARAM_COUNT) {
     initFromChunk(ctx);
 }
 
@@ -66,10 +67,6 @@ std::string MasterTrackInfo::getChunkId() const {
     return "MASTERTRACKINFO";
 }
 
-std::set<std::string> MasterTrackInfo::getKeys() const {
-    return BaseTrackInfo::getKeys();
-}
-
 char * MasterTrackInfo::getTreeText() const {
     std::string newText = getFilterText() + " Master";
     newText.copy(mTreeText, newText.length());
@@ -96,19 +93,14 @@ FilterPreset* MasterTrackInfo::extractFilterPreset() {
 bool MasterTrackInfo::applyFilterPreset(FilterPreset *preset) {
     if (preset->mType == MASTERTRACK) {
         mFilter = preset->mFilter;
-        auto toFilters = std::set<Filterable*>();
-        toFilters.insert(&mParamInfo);
-        toFilters.insert(mHwSends.begin(), mHwSends.end());
-        toFilters.insert(mFxs.begin(), mFxs.end());
-
-        for (auto child : preset->mChilds) {
-            for (auto toFilter : toFilters) {
-                if (toFilter->applyFilterPreset(child)) {
-                    toFilters.erase(toFilter);
-                    goto cnt;
-                }
-            }
-            cnt:;
+
+        auto index = FilterPresetIndex(preset->mChilds);
+        index.apply(mParamInfo, PARAMS);
+        for (auto hwSend : mHwSends) {
+            index.apply(*hwSend, SEND, (int) hwSend->mParamInfo.valueAt(SendParam::DSTCHAN));
+        }
+        for (auto fx : mFxs) {
+            index.apply(*fx, FX, fx->mGuid);
         }
         return true;
     }
@@ -44,7 +44,6 @@ public:
     FilterPreset* extractFilterPreset() override;
     bool applyFilterPreset(FilterPreset *preset) override;
 protected:
-    [[nodiscard]] std::set<std::string> getKeys() const override;
     [[nodiscard]] MediaTrack *getMediaTrack() const override;
     [[nodiscard]] std::string getChunkId() const override;
 private:
@@ -34,10 +34,12 @@
 template<typename T> class Parameter;
 class ParameterInfo;
 class FxInfo;
+class BaseTrackInfo;
 class HwSendInfo;
 class SwSendInfo;
 class TrackInfo;
 class MasterTrackInfo;
 class LivePreset;
+class RecallPlan;
 
 #endif //LPE_MODELS_FWD_H
\ No newline at end of file
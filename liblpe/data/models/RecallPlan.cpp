@@ -0,0 +1,390 @@
+/******************************************************************************
+/ LivePresetsExtension
+/
+/ Flat list of write operations compiled from a LivePreset
+/
+/ Copyright (c) 2020 and later Dr. med. Frederik Bertling
+/
+/
+/ Permission is hereby granted, free of charge, to any person obtaining a copy
+/ of this software and associated documentation files (the "Software"), to deal
+/ in the Software without restriction, including without limitation the rights to
+/ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+/ of the Software, and to permit persons to whom the Software is furnished to
+/ do so, subject to the following conditions:
+/
+/ The above copyright notice and this permission notice shall be included in all
+/ copies or substantial portions of the Software.
+/
+/ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+/ EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+/ OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+/ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+/ HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+/ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/ FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+/ OTHER DEALINGS IN THE SOFTWARE.
+/
+******************************************************************************/
+
+#include <liblpe/data/models/RecallPlan.h>
+#include <liblpe/data/models/LivePreset.h>
+#include <liblpe/LivePresetsExtension.h>
+#include <reaper_plugin_functions.h>
+#include <liblpe/util/util.h>
+#include <map>
+#include <optional>
+#include <algorithm>
+#include <chrono>
+#include <unordered_set>
+#include <unordered_map>
+
+/**
+ * Rebuilds the plan from the given preset
+ * @param preset the preset to compile
+ */
+void RecallPlan::compile(const LivePreset* preset) {
+    mOps.clear();
+    mFxIndices.clear();
+    mFxInfos.clear();
+
+    //the hide muted tracks option is resolved while compiling
+    mIsHideMutedTracks = g_lpe->mModel->mIsHideMutedTracks;
+    mTrackGeneration = g_lpe->mModel->mTrackIndex.getGeneration();
+
+    addSection(RecallProfiler::MASTERTRACK, nullptr);
+    preset->mMasterTrack->compileRecall(*this);
+    for (auto* const track : preset->mTracks) {
+        addSection(RecallProfiler::TRACK, track);
+        track->compileRecall(*this);
+    }
+    //ControlInfo does not recall anything yet, so there is nothing to compile
+
+    createSliceOrder();
+    mRevision = nextRevision();
+    mIsCompiled = true;
+}
+
+/**
+ * Compiles the operations needed to go from one preset to another. Values that are equal in both plans are skipped,
+ * values that were written by the first plan but differ are written without reading the current value first.
+ * Sends and fx structure still have to be matched against the current state and are always kept.
+ * @param from the plan of the preset that is currently active
+ * @param to the plan of the preset that will be recalled
+ */
+void RecallPlan::compileTransition(const RecallPlan& from, const RecallPlan& to) {
+    auto fromValues = std::map<std::pair<MediaTrack*, const char*>, double>();
+    auto fromSlots = std::unordered_map<GUID, int, GuidHash, GuidEqual>();
+    auto fromParams = std::vector<std::unordered_map<int, double>>(from.mFxIndices.size());
+    for (const auto& op : from.mOps) {
+        if (op.type == TRACK_VALUE)
+            fromValues[{op.track, op.key}] = op.value;
+        else if (op.type == FX)
+            fromSlots[op.fxInfo->mGuid] = op.slot;
+        else if (op.type == FX_PARAM)
+            fromParams[op.slot][op.param] = op.value;
+    }
+
+    mOps.clear();
+    mFxIndices = to.mFxIndices;
+    mFxInfos = to.mFxInfos;
+    //maps the fx slots of to onto the slots of from
+    auto slots = std::vector<int>(to.mFxIndices.size(), -1);
+
+    for (auto op : to.mOps) {
+        switch (op.type) {
+            case TRACK_VALUE: {
+                auto it = fromValues.find({op.track, op.key});
+                if (it != fromValues.end()) {
+                    if (it->second == op.value)
+                        continue;
+                    op.type = TRACK_VALUE_WRITE;
+                }
+                break;
+            }
+            case FX: {
+                auto it = fromSlots.find(op.fxInfo->mGuid);
+                if (it != fromSlots.end())
+                    slots[op.slot] = it->second;
+                break;
+            }
+            case FX_PARAM: {
+                if (slots[op.slot] == -1)
+                    break;
+                auto& params = fromParams[slots[op.slot]];
+                auto it = params.find(op.param);
+                if (it != params.end()) {
+                    if (it->second == op.value)
+                        continue;
+                    op.type = FX_PARAM_WRITE;
+                }
+                break;
+            }
+            default:
+                break;
+        }
+        mOps.push_back(op);
+    }
+
+    mIsHideMutedTracks = to.mIsHideMutedTracks;
+    mTrackGeneration = to.mTrackGeneration;
+    mFromRevision = from.mRevision;
+    mToRevision = to.mRevision;
+    createSliceOrder();
+    mRevision = nextRevision();
+    mIsCompiled = true;
+}
+
+/**
+ * Recalls the compiled preset, only changes values that differ from the current state
+ */
+void RecallPlan::execute() {
+    //measures the master track and every track, recorded when the next section starts
+    std::optional<RecallProfiler::Timer> section;
+
+    for (size_t i = 0; i < mOps.size(); i++) {
+        const auto& op = mOps[i];
+        switch (op.type) {
+            case SECTION:
+                section.reset();
+                if (op.sectionTrack)
+                    section.emplace((RecallProfiler::Stage) op.param, op.sectionTrack->mGuid,
+                                    op.sectionTrack->mName.mValue);
+                else
+                    section.emplace((RecallProfiler::Stage) op.param);
+                break;
+            case TRACK_VALUE:
+            case TRACK_VALUE_WRITE:
+            case HW_SENDS:
+            case SW_SENDS:
+            case FX:
+                executeOp(op);
+                break;
+            case FX_PARAM:
+            case FX_PARAM_WRITE:
+                i = executeFxParams(i) - 1;
+                break;
+        }
+    }
+}
+
+/**
+ * Executes the operations in the order of a sliced recall until the time budget is used up, at least one operation is
+ * executed
+ * @param position the position returned by the last slice, 0 for the first slice
+ * @param budgetUs the time budget in microseconds
+ * @return the position to continue with
+ */
+size_t RecallPlan::executeSlice(size_t position, double budgetUs) {
+    auto start = std::chrono::steady_clock::now();
+    auto budget = std::chrono::duration<double, std::micro>(budgetUs);
+
+    while (position < mSliceOrder.size()) {
+        executeOp(mOps[mSliceOrder[position]]);
+        position++;
+        if (std::chrono::steady_clock::now() - start >= budget)
+            break;
+    }
+    return position;
+}
+
+bool RecallPlan::isFinished(size_t position) const {
+    return position >= mSliceOrder.size();
+}
+
+void RecallPlan::executeOp(const Op& op) {
+    auto& shadowState = g_lpe->mModel->mShadowState;
+    switch (op.type) {
+        case SECTION:
+            break;
+        case TRACK_VALUE:
+        case TRACK_VALUE_WRITE:
+            //layout changes are deferred until the audible changes are done
+            if (op.param)
+                g_lpe->mModel->setLayoutValue(op.track, op.key, op.value);
+            else
+                shadowState.setTrackValue(op.track, op.key, op.value, op.type == TRACK_VALUE);
+            break;
+        case HW_SENDS:
+            op.trackInfo->recallHwSends();
+            break;
+        case SW_SENDS:
+            static_cast<const TrackInfo*>(op.trackInfo)->recallSwSends();
+            break;
+        case FX:
+            mFxIndices[op.slot] = op.fxInfo->recallStructure(op.track);
+            break;
+        case FX_PARAM:
+        case FX_PARAM_WRITE: {
+            int index = mFxIndices[op.slot];
+            if (index != -1)
+                shadowState.setFxParam(op.track, index, op.param, op.value, op.type == FX_PARAM);
+            break;
+        }
+    }
+}
+
+/**
+ * Recalls all parameters of the fx starting at begin
+ * @return the index of the first operation that does not belong to the fx
+ */
+size_t RecallPlan::executeFxParams(size_t begin) {
+    int slot = mOps[begin].slot;
+    int index = mFxIndices[slot];
+    RecallProfiler::Timer timer(RecallProfiler::FX_PARAMETERS, mFxInfos[slot]->mGuid, mFxInfos[slot]->mName);
+
+    auto& shadowState = g_lpe->mModel->mShadowState;
+    size_t i = begin;
+    for (; i < mOps.size() && mOps[i].slot == slot; i++) {
+        const auto& op = mOps[i];
+        if (op.type != FX_PARAM && op.type != FX_PARAM_WRITE)
+            break;
+        if (index != -1)
+            shadowState.setFxParam(op.track, index, op.param, op.value, op.type == FX_PARAM);
+    }
+    return i;
+}
+
+void RecallPlan::invalidate() {
+    mIsCompiled = false;
+}
+
+/**
+ * A plan is only valid for the track list and settings it was compiled with
+ */
+bool RecallPlan::isValid() const {
+    return mIsCompiled
+            && mTrackGeneration == g_lpe->mModel->mTrackIndex.getGeneration()
+            && mIsHideMutedTracks == g_lpe->mModel->mIsHideMutedTracks;
+}
+
+/**
+ * A transition is only valid as long as both plans were not recompiled since
+ */
+bool RecallPlan::isTransition(const RecallPlan& from, const RecallPlan& to) const {
+    return mIsCompiled && from.mIsCompiled && to.mIsCompiled
+            && mFromRevision == from.mRevision && mToRevision == to.mRevision;
+}
+
+/**
+ * Starts a new section of operations that is measured as one stage
+ */
+void RecallPlan::addSection(RecallProfiler::Stage stage, const TrackInfo* track) {
+    Op op{};
+    op.type = SECTION;
+    op.param = stage;
+    op.sectionTrack = track;
+    mOps.push_back(op);
+}
+
+/**
+ * @param key an interned key
+ */
+void RecallPlan::addTrackValue(MediaTrack* track, const char* key, double value) {
+    Op op{};
+    op.type = TRACK_VALUE;
+    op.track = track;
+    op.key = key;
+    op.param = isLayoutKey(op.key);
+    op.value = value;
+    mOps.push_back(op);
+}
+
+void RecallPlan::addHwSends(const BaseTrackInfo* info) {
+    Op op{};
+    op.type = HW_SENDS;
+    op.trackInfo = info;
+    mOps.push_back(op);
+}
+
+void RecallPlan::addSwSends(const TrackInfo* info) {
+    Op op{};
+    op.type = SW_SENDS;
+    op.trackInfo = info;
+    mOps.push_back(op);
+}
+
+/**
+ * Adds the structural recall of a fx (position, enabled state, plugin preset)
+ * @return the slot that has to be used for the parameters of this fx
+ */
+int RecallPlan::addFx(const FxInfo* info, MediaTrack* track) {
+    Op op{};
+    op.type = FX;
+    op.slot = (int) mFxIndices.size();
+    op.track = track;
+    op.fxInfo = info;
+    mOps.push_back(op);
+    mFxIndices.push_back(-1);
+    mFxInfos.push_back(info);
+    return op.slot;
+}
+
+void RecallPlan::addFxParam(int slot, MediaTrack* track, int param, double value) {
+    Op op{};
+    op.type = FX_PARAM;
+    op.slot = slot;
+    op.param = param;
+    op.track = track;
+    op.value = value;
+    mOps.push_back(op);
+}
+
+/**
+ * Track values that only change the arrangement of the tcp and mcp but not the sound
+ * The selection is not deferred, actions and scripts that recall a preset work on the selected tracks right after
+ */
+bool RecallPlan::isLayoutKey(const char* key) {
+    static const std::unordered_set<const char*> keys = {
+            InternString(I_HEIGHTOVERRIDE),
+            InternString(B_HEIGHTLOCK),
+            InternString(I_CUSTOMCOLOR),
+            InternString(I_FOLDERCOMPACT),
+            InternString(B_SHOWINMIXER),
+            InternString(B_SHOWINTCP)
+    };
+    return keys.count(key) > 0;
+}
+
+/**
+ * Sorts the operations by their priority, the relative order of operations with the same priority is kept so fx
+ * parameters still follow their fx
+ */
+void RecallPlan::createSliceOrder() {
+    mSliceOrder.clear();
+    for (unsigned int i = 0; i < mOps.size(); i++) {
+        if (mOps[i].type != SECTION)
+            mSliceOrder.push_back(i);
+    }
+    std::stable_sort(mSliceOrder.begin(), mSliceOrder.end(), [this](unsigned int a, unsigned int b) {
+        return getSlicePriority(mOps[a]) < getSlicePriority(mOps[b]);
+    });
+}
+
+int RecallPlan::getSlicePriority(const Op& op) {
+    static const char* mute = InternString(B_MUTE);
+    static const char* solo = InternString(I_SOLO);
+
+    switch (op.type) {
+        case TRACK_VALUE:
+        case TRACK_VALUE_WRITE:
+            if (op.key == mute || op.key == solo)
+                return 0;
+            return op.param ? 5 : 1;
+        case HW_SENDS:
+        case SW_SENDS:
+            return 2;
+        case FX:
+            return 3;
+        case FX_PARAM:
+        case FX_PARAM_WRITE:
+            return 4;
+        default:
+            return 6;
+    }
+}
+
+unsigned int RecallPlan::nextRevision() {
+    static unsigned int revision = 0;
+    return ++revision;
+}
\ No newline at end of file
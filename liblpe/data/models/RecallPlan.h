@@ -0,0 +1,122 @@
+/******************************************************************************
+/ LivePresetsExtension
+/
+/ Flat list of write operations compiled from a LivePreset
+/
+/ Copyright (c) 2020 and later Dr. med. Frederik Bertling
+/
+/
+/ Permission is hereby granted, free of charge, to any person obtaining a copy
+/ of this software and associated documentation files (the "Software"), to deal
+/ in the Software without restriction, including without limitation the rights to
+/ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+/ of the Software, and to permit persons to whom the Software is furnished to
+/ do so, subject to the following conditions:
+/
+/ The above copyright notice and this permission notice shall be included in all
+/ copies or substantial portions of the Software.
+/
+/ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+/ EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+/ OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+/ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+/ HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+/ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/ FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+/ OTHER DEALINGS IN THE SOFTWARE.
+/
+******************************************************************************/
+
+#ifndef LPE_RECALLPLAN_H
+#define LPE_RECALLPLAN_H
+
+#include <string>
+#include <vector>
+#include <liblpe/data/models/Models.fwd.h>
+#include <liblpe/util/RecallProfiler.h>
+
+class MediaTrack;
+
+/**
+ * A LivePreset compiled into a contiguous array of typed write operations. Tracks are resolved, keys are interned and
+ * filtered values are already removed, so recalling the preset does not walk the object graph anymore.
+ * Operations that depend on the current project state (matching sends, moving fx) are kept as single structural steps.
+ * The plan has to be recompiled when the preset, its filters or the track list change.
+ *
+ * A transition plan is compiled from the plans of two presets and only contains the operations whose values differ.
+ * It may only be executed while the project is still in the state of the first preset.
+ *
+ * A plan can also be executed in slices with a time budget. Slices recall audible changes first (mute/solo, other
+ * track values, sends, fx structure), then fx parameters and track values that only change the layout.
+ */
+class RecallPlan {
+public:
+    void compile(const LivePreset* preset);
+    void compileTransition(const RecallPlan& from, const RecallPlan& to);
+    void execute();
+    [[nodiscard]] size_t executeSlice(size_t position, double budgetUs);
+    [[nodiscard]] bool isFinished(size_t position) const;
+    void invalidate();
+    [[nodiscard]] bool isValid() const;
+    [[nodiscard]] bool isTransition(const RecallPlan& from, const RecallPlan& to) const;
+
+    //called by the models while compiling
+    void addTrackValue(MediaTrack* track, const char* key, double value);
+    void addHwSends(const BaseTrackInfo* info);
+    void addSwSends(const TrackInfo* info);
+    int addFx(const FxInfo* info, MediaTrack* track);
+    void addFxParam(int slot, MediaTrack* track, int param, double value);
+
+    static bool isLayoutKey(const char* key);
+private:
+    enum OpType : unsigned char {
+        SECTION,
+        TRACK_VALUE,
+        TRACK_VALUE_WRITE,
+        HW_SENDS,
+        SW_SENDS,
+        FX,
+        FX_PARAM,
+        FX_PARAM_WRITE
+    };
+
+    struct Op {
+        OpType type;
+        int slot;
+        //fx parameter index, stage of a section, layout flag of a track value
+        int param;
+        MediaTrack* track;
+        union {
+            const char* key;
+            const BaseTrackInfo* trackInfo;
+            const FxInfo* fxInfo;
+            //the measured track of a section, nullptr for the master track
+            const TrackInfo* sectionTrack;
+        };
+        double value;
+    };
+
+    std::vector<Op> mOps;
+    //current index of every fx of the plan, written by the FX op and read by its FX_PARAM ops
+    std::vector<int> mFxIndices;
+    std::vector<const FxInfo*> mFxInfos;
+    //indices of mOps in the order of a sliced recall
+    std::vector<unsigned int> mSliceOrder;
+    bool mIsCompiled = false;
+    bool mIsHideMutedTracks = false;
+    unsigned int mTrackGeneration = 0;
+    //unique for every compilation, transitions store the revisions of the plans they were compiled from
+    unsigned int mRevision = 0;
+    unsigned int mFromRevision = 0;
+    unsigned int mToRevision = 0;
+
+    void addSection(RecallProfiler::Stage stage, const TrackInfo* track);
+    void executeOp(const Op& op);
+    size_t executeFxParams(size_t begin);
+    void createSliceOrder();
+    static int getSlicePriority(const Op& op);
+    static unsigned int nextRevision();
+};
+
+
+#endif //LPE_RECALLPLAN_H
\ No newline at end of file
@@ -30,6 +30,7 @@
 #include <liblpe/data/models/SwSendInfo.h>
 #include <reaper_plugin_functions.h>
 #include <liblpe/util/util.h>
+#include <liblpe/LivePresetsExtension.h>
 #include <liblpe/data/models/FilterPreset.h>
 #include <liblpe/data/models/base/BaseTrackInfo.h>
 
@@ -58,11 +59,7 @@ void SwSendInfo::saveCurrentState(bool update) {
     mDstTrackGuid = *GetTrackGUID(dstTrack);
 
     //get track settings
-    for (const auto& key : getKeys()) {
-        FilterMode filter = update ? mParamInfo.at(key).mFilter : RECALLED;
-        auto param = Parameter<double>(&mParamInfo, key, GetTrackSendInfo_Value(getSrcTrack(), 0, mSendIdx, key.data()), filter);
-        mParamInfo.insert(key, param);
-    }
+    saveSendState(0, update);
 }
 
 /**
@@ -79,13 +76,10 @@ void SwSendInfo::recallSettings() const {
     if (mSendIdx < 0)
         mSendIdx = CreateTrackSend(getSrcTrack(), getDstTrack());
 
-    for (const auto& key : getKeys()) {
-        if (GetTrackSendInfo_Value(tr, 0, mSendIdx, key.data()) != mParamInfo.at(key).mValue)
-            SetTrackSendInfo_Value(tr, 0, mSendIdx, key.data(), mParamInfo.at(key).mValue);
-    }
+    recallSendState(tr, 0);
 }
 
-bool SwSendInfo::initFromChunkHandler(std::string &key, std::vector<const char *> &params) {
+bool SwSendInfo::initFromChunkHandler(std::string_view key, std::vector<const char *> &params) {
     if (key == "DSTGUID") {
         stringToGuid(params[0], &mDstTrackGuid);
         return true;
@@ -93,7 +87,7 @@ bool SwSendInfo::initFromChunkHandler(std::string &key, std::vector<const char *
     return BaseSendInfo::initFromChunkHandler(key, params);
 }
 
-void SwSendInfo::persistHandler(WDL_FastString &str) const {
+void SwSendInfo::persistHandler(ChunkWriter &str) const {
     BaseSendInfo::persistHandler(str);
 
     char dst[64];
@@ -109,12 +103,7 @@ MediaTrack* SwSendInfo::getDstTrack() const {
     if (GuidsEqual(mDstTrackGuid, BaseTrackInfo::MASTER_GUID))
         return GetMasterTrack(nullptr);
 
-    for (int i = 0; i < CountTracks(nullptr); ++i) {
-        MediaTrack* track = GetTrack(nullptr, i);
-        if (GuidsEqual(mDstTrackGuid, *GetTrackGUID(track)))
-            return track;
-    }
-    return nullptr;
+    return GetTrackByGUID(mDstTrackGuid);
 }
 
 /**
@@ -122,21 +111,7 @@ MediaTrack* SwSendInfo::getDstTrack() const {
  * @return the MediaTrack*
  */
 MediaTrack* SwSendInfo::getSrcTrack() const {
-    for (int i = 0; i < CountTracks(nullptr); ++i) {
-        MediaTrack* track = GetTrack(nullptr, i);
-        if (GuidsEqual(mSrcTrackGuid, *GetTrackGUID(track)))
-            return track;
-    }
-    return nullptr;
-}
-
-std::set<std::string> SwSendInfo::getKeys() const {
-    auto set = BaseSendInfo::getKeys();
-    std::set<std::string> keys = {
-
-    };
-    set.insert(keys.begin(), keys.end());
-    return set;
+    return GetTrackByGUID(mSrcTrackGuid);
 }
 
 char * SwSendInfo::getTreeText() const {
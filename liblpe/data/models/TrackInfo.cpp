@@ -30,13 +30,17 @@
 #include <liblpe/data/models/TrackInfo.h>
 #include <liblpe/util/util.h>
 #include <liblpe/data/models/FilterPreset.h>
+#include <liblpe/data/models/RecallPlan.h>
 #include <reaper_plugin_functions.h>
+#include <liblpe/LivePresetsExtension.h>
 
-TrackInfo::TrackInfo(Filterable* parent, MediaTrack *track) : BaseTrackInfo(parent), mGuid(*GetTrackGUID(track)) {
+TrackInfo::TrackInfo(Filterable* parent, MediaTrack *track) : BaseTrackInfo(parent, (size_t) TrackParam::COUNT),
+        mGuid(*GetTrackGUID(track)) {
     TrackInfo::saveCurrentState(false);
 }
 
-TrackInfo::TrackInfo(Filterable* parent, ProjectStateContext* ctx) : BaseTrackInfo(parent) {
+TrackInfo::TrackInfo(Filterable* parent, ProjectStateContext* ctx) :
+        BaseTrackInfo(parent, (size_t) TrackParam::COUNT) {
     initFromChunk(ctx);
 }
 
@@ -66,19 +70,19 @@ void TrackInfo::saveCurrentState(bool update) {
     BaseTrackInfo::saveFxState(nullptr, mRecFxs, getMediaTrack(), &mGuid, update, true);
 }
 
-bool TrackInfo::initFromChunkHandler(std::string& key, std::vector<const char*>& params) {
+bool TrackInfo::initFromChunkHandler(std::string_view key, std::vector<const char*>& params) {
     if (key == "GUID") {
         stringToGuid(params[0], &mGuid);
         return true;
     }
     if (key == "NAME") {
-        mName = Parameter<std::string>(this, "NAME", params[0], (FilterMode) std::stoi(params[1]));
+        mName = Parameter<std::string>(this, "NAME", params[0], (FilterMode) ParseInt(params[1]));
         return true;
     }
     return BaseTrackInfo::initFromChunkHandler(key, params);
 }
 
-bool TrackInfo::initFromChunkHandler(std::string &key, ProjectStateContext *ctx) {
+bool TrackInfo::initFromChunkHandler(std::string_view key, ProjectStateContext *ctx) {
     if (key == "RECFXINFO") {
         mRecFxs.push_back(new FxInfo(this, ctx));
         return true;
@@ -104,6 +108,41 @@ void TrackInfo::recallSettings() const {
         SetTrackStateChunk(getMediaTrack(), chunk.data(), false);
     }*/
 
+    recallSwSends();
+
+    //assign input plugin settings
+    auto muted = (bool) mParamInfo.valueAt(TrackParam::MUTE);
+    if (!muted) {
+        for (const auto* recFxInfo : mRecFxs) {
+            recFxInfo->recallSettings();
+        }
+    }
+}
+
+/**
+ * Adds the track and its sends and input fxs to the plan
+ */
+void TrackInfo::compileRecall(RecallPlan& plan) const {
+    if (isFilteredInChain() || !getMediaTrack())
+        return;
+    BaseTrackInfo::compileRecall(plan);
+
+    plan.addSwSends(this);
+
+    auto muted = (bool) mParamInfo.valueAt(TrackParam::MUTE);
+    if (!muted) {
+        for (const auto* recFxInfo : mRecFxs) {
+            recFxInfo->compileRecall(plan);
+        }
+    }
+}
+
+/**
+ * Matches the sends of the track with the saved sends, removes obsolete ones and creates missing ones
+ */
+void TrackInfo::recallSwSends() const {
+    RecallProfiler::Timer timer(RecallProfiler::SENDS);
+
     //prepare lists for matching sends (that can be reused) and nonMatching sends (that have to be removed)
     auto nonMatchingSends = std::set<SwSendInfo*>(mSwSends.begin(), mSwSends.end());
     auto matchingSends = std::vector<SwSendInfo*>(GetTrackNumSends(getMediaTrack(), 0));
@@ -124,6 +163,7 @@ void TrackInfo::recallSettings() const {
             }
         }
         RemoveTrackSend(getMediaTrack(), 0, i);
+        g_lpe->mModel->mShadowState.invalidateSends(getMediaTrack());
         matchingSends.erase(matchingSends.begin() + i);
         matched:;
     }
@@ -138,17 +178,9 @@ void TrackInfo::recallSettings() const {
         send->mSendIdx = -1;
         send->recallSettings();
     }
-
-    //assign input plugin settings
-    auto muted = (bool) mParamInfo.at(B_MUTE).mValue;
-    if (!muted) {
-        for (const auto* recFxInfo : mRecFxs) {
-            recFxInfo->recallSettings();
-        }
-    }
 }
 
-void TrackInfo::persistHandler(WDL_FastString &str) const {
+void TrackInfo::persistHandler(ChunkWriter &str) const {
     BaseTrackInfo::persistHandler(str);
 
     char dest[64];
@@ -166,36 +198,7 @@ void TrackInfo::persistHandler(WDL_FastString &str) const {
 }
 
 MediaTrack* TrackInfo::getMediaTrack() const {
-    for (int i = 0; i < CountTracks(nullptr); ++i) {
-        MediaTrack* track = GetTrack(nullptr, i);
-        if (GuidsEqual(mGuid, *GetTrackGUID(track)))
-            return track;
-    }
-    return nullptr;
-}
-
-std::set<std::string> TrackInfo::getKeys() const {
-    auto set = BaseTrackInfo::getKeys();
-    std::set<std::string> keys = {
-            B_PHASE,
-            I_RECARM,
-            I_RECINPUT,
-            I_RECMODE,
-            I_RECMON,
-            I_RECMONITEMS,
-            I_FOLDERDEPTH,
-            I_FOLDERCOMPACT,
-            I_PANMODE,
-            D_PANLAW,
-            B_SHOWINMIXER,
-            B_SHOWINTCP,
-            B_MAINSEND,
-            C_MAINSEND_OFFS,
-            B_FREEMODE,
-    };
-
-    set.insert(keys.begin(),keys.end());
-    return set;
+    return GetTrackByGUID(mGuid);
 }
 
 char * TrackInfo::getTreeText() const {
@@ -236,22 +239,20 @@ bool TrackInfo::applyFilterPreset(FilterPreset *preset) {
     if (preset->mType == TRACK && GuidsEqual(preset->mId.guid, mGuid)) {
         mFilter = preset->mFilter;
 
-        auto toFilters = std::set<Filterable*>();
-        toFilters.insert(&mParamInfo);
-        toFilters.insert(&mName);
-        toFilters.insert(mSwSends.begin(), mSwSends.end());
-        toFilters.insert(mHwSends.begin(), mHwSends.end());
-        toFilters.insert(mFxs.begin(), mFxs.end());
-        toFilters.insert(mRecFxs.begin(), mRecFxs.end());
-
-        for (auto* child : preset->mChilds) {
-            for (auto* toFilter : toFilters) {
-                if (toFilter->applyFilterPreset(child)) {
-                    toFilters.erase(toFilter);
-                    goto cnt;
-                }
-            }
-            cnt:;
+        auto index = FilterPresetIndex(preset->mChilds);
+        index.apply(mParamInfo, PARAMS);
+        index.apply(mName, PARAM, mName.mKey);
+        for (auto* swSend : mSwSends) {
+            index.apply(*swSend, SEND, swSend->mDstTrackGuid);
+        }
+        for (auto* hwSend : mHwSends) {
+            index.apply(*hwSend, SEND, (int) hwSend->mParamInfo.valueAt(SendParam::DSTCHAN));
+        }
+        for (auto* fx : mFxs) {
+            index.apply(*fx, FX, fx->mGuid);
+        }
+        for (auto* recFx : mRecFxs) {
+            index.apply(*recFx, FX, recFx->mGuid);
         }
         return true;
     }
@@ -32,21 +32,6 @@
 
 #include <liblpe/data/models/base/BaseTrackInfo.h>
 
-//define used parameters
-#define B_PHASE "B_PHASE"
-#define I_RECARM "I_RECARM"
-#define I_RECINPUT "I_RECINPUT"
-#define I_RECMODE "I_RECMODE"
-#define I_RECMON "I_RECMON"
-#define I_RECMONITEMS "I_RECMONITEMS"
-#define I_FOLDERDEPTH "I_FOLDERDEPTH"
-#define I_FOLDERCOMPACT "I_FOLDERCOMPACT"
-#define B_SHOWINMIXER "B_SHOWINMIXER"
-#define B_SHOWINTCP "B_SHOWINTCP"
-#define B_MAINSEND "B_MAINSEND"
-#define C_MAINSEND_OFFS "C_MAINSEND_OFFS"
-#define B_FREEMODE "B_FREEMODE"
-
 class TrackInfo final : public BaseTrackInfo {
 public:
     explicit TrackInfo(Filterable* parent, MediaTrack* track);
@@ -64,13 +49,14 @@ public:
     void saveCurrentState(bool update) override;
 
     void recallSettings() const override;
+    void compileRecall(RecallPlan& plan) const override;
+    void recallSwSends() const;
     FilterPreset* extractFilterPreset() override;
     bool applyFilterPreset(FilterPreset *preset) override;
 protected:
-    [[nodiscard]] std::set<std::string> getKeys() const override;
-    bool initFromChunkHandler(std::string &key, std::vector<const char*> &params) override;
-    bool initFromChunkHandler(std::string &key, ProjectStateContext *ctx) override;
-    void persistHandler(WDL_FastString &str) const override;
+    bool initFromChunkHandler(std::string_view key, std::vector<const char*> &params) override;
+    bool initFromChunkHandler(std::string_view key, ProjectStateContext *ctx) override;
+    void persistHandler(ChunkWriter &str) const override;
     [[nodiscard]] MediaTrack *getMediaTrack() const override;
     [[nodiscard]] std::string getChunkId() const override;
 };
@@ -28,15 +28,20 @@
 ******************************************************************************/
 
 #include <liblpe/data/models/base/BaseInfo.h>
+#include <liblpe/util/util.h>
 
-BaseInfo::BaseInfo(Filterable *parent) : Filterable(parent) {}
+/**
+ * @param layout the named parameters of this object
+ */
+BaseInfo::BaseInfo(Filterable *parent, const ParameterLayout* layout) : Filterable(parent),
+        mParamInfo(this, layout) {}
 
 /**
  * Function to help persisting data
  * BaseInfo persists ParameterInfo and Filter
  * @param str add data to this string
  */
-void BaseInfo::persistHandler(WDL_FastString &str) const {
+void BaseInfo::persistHandler(ChunkWriter &str) const {
     mParamInfo.persist(str);
     str.AppendFormatted(4096, "FILTERMODE %u\n", mFilter);
 }
@@ -47,13 +52,10 @@ void BaseInfo::persistHandler(WDL_FastString &str) const {
  * @param key element key
  * @param ctx reaper chunk data
  */
-bool BaseInfo::initFromChunkHandler(std::string &key, ProjectStateContext* ctx) {
+bool BaseInfo::initFromChunkHandler(std::string_view key, ProjectStateContext* ctx) {
     if (key == "PARAMETERINFO") {
-        mParamInfo = ParameterInfo(this, ctx);
-        //fix parent after copy assignment
-        for (auto& entry : mParamInfo.mParams) {
-            entry.second.mParent = &mParamInfo;
-        }
+        //load into the existing layout
+        mParamInfo.initFromChunk(ctx);
         return true;
     }
     return false;
@@ -65,9 +67,9 @@ bool BaseInfo::initFromChunkHandler(std::string &key, ProjectStateContext* ctx)
  * @param key data key
  * @param params data values
  */
-bool BaseInfo::initFromChunkHandler(std::string &key, std::vector<const char*> &params) {
+bool BaseInfo::initFromChunkHandler(std::string_view key, std::vector<const char*> &params) {
     if (key == "FILTERMODE") {
-        mFilter = (FilterMode) std::stoi(params[0]);
+        mFilter = (FilterMode) ParseInt(params[0]);
         return true;
     }
     return false;
@@ -36,17 +36,17 @@
 
 class BaseInfo : public Filterable, public Persistable {
 public:
-    explicit BaseInfo(Filterable* parent);
+    explicit BaseInfo(Filterable* parent, const ParameterLayout* layout = nullptr);
 
-    ParameterInfo mParamInfo = ParameterInfo(this);
+    ParameterInfo mParamInfo;
 
     virtual void recallSettings() const = 0;
     virtual void saveCurrentState(bool update) = 0;
 protected:
     [[nodiscard]] virtual std::set<std::string> getKeys() const;
-    void persistHandler(WDL_FastString &str) const override;
-    bool initFromChunkHandler(std::string &key, std::vector<const char*> &params) override;
-    bool initFromChunkHandler(std::string &key, ProjectStateContext* ctx) override;
+    void persistHandler(ChunkWriter &str) const override;
+    bool initFromChunkHandler(std::string_view key, std::vector<const char*> &params) override;
+    bool initFromChunkHandler(std::string_view key, ProjectStateContext* ctx) override;
 };
 
 #endif //LPE_BASEINFO_H
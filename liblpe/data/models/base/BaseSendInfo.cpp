@@ -29,28 +29,40 @@
 
 #include <liblpe/data/models/base/BaseSendInfo.h>
 #include <reaper_plugin_functions.h>
+#include <liblpe/LivePresetsExtension.h>
+#include <liblpe/util/util.h>
 
-BaseSendInfo::BaseSendInfo(Filterable *parent) : BaseInfo(parent) {}
+static_assert((size_t) SendParam::COUNT <= ParameterInfo::NAMED_CAPACITY);
+
+/**
+ * Returns the layout of the send parameters
+ */
+static const ParameterLayout* getParamLayout() {
+    static const ParameterLayout layout(SEND_PARAM_KEYS, (size_t) SendParam::COUNT);
+    return &layout;
+}
+
+BaseSendInfo::BaseSendInfo(Filterable *parent) : BaseInfo(parent, getParamLayout()) {}
 
 /**
  * Create a new SendInfo object from a track
  * @param trackGuid the track guid
  * @param sendidx the id of the send
  */
-BaseSendInfo::BaseSendInfo(Filterable* parent, GUID trackGuid, int sendidx) : BaseInfo(parent),
+BaseSendInfo::BaseSendInfo(Filterable* parent, GUID trackGuid, int sendidx) : BaseInfo(parent, getParamLayout()),
         mSendIdx(sendidx), mSrcTrackGuid(trackGuid) {
     BaseSendInfo::saveCurrentState(false);
 }
 
 void BaseSendInfo::saveCurrentState(bool update) {}
 
-bool BaseSendInfo::initFromChunkHandler(std::string& key, std::vector<const char*>& params) {
+bool BaseSendInfo::initFromChunkHandler(std::string_view key, std::vector<const char*>& params) {
     if (key == "SRCGUID") {
         stringToGuid(params[0], &mSrcTrackGuid);
         return true;
     }
 
-    mParamInfo.insert(key, Parameter<double>(&mParamInfo, key, std::stod(params[0]), (FilterMode) std::stoi(params[1])));
+    mParamInfo.insert(key, ParseDouble(params[0]), (FilterMode) ParseInt(params[1]));
     return true;
 }
 
@@ -59,7 +71,7 @@ void BaseSendInfo::recallSettings() const {
         return;
 }
 
-void BaseSendInfo::persistHandler(WDL_FastString &str) const {
+void BaseSendInfo::persistHandler(ChunkWriter &str) const {
     BaseInfo::persistHandler(str);
 
     char src[64];
@@ -68,21 +80,26 @@ void BaseSendInfo::persistHandler(WDL_FastString &str) const {
     str.AppendFormatted(4096, "SRCGUID %s\n", src);
 }
 
-std::set<std::string> BaseSendInfo::getKeys() const {
-    auto set = BaseInfo::getKeys();
-    std::set<std::string> keys = {
-            B_MUTE,
-            B_MONO,
-            B_PHASE,
-            D_VOL,
-            D_PAN,
-            D_PANLAW,
-            I_SENDMODE,
-            I_AUTOMODE,
-            I_SRCCHAN,
-            I_DSTCHAN,
-            I_MIDIFLAGS
-    };
-    set.insert(keys.begin(), keys.end());
-    return set;
+/**
+ * Saves all send parameters of the send at mSendIdx
+ * @param category 0 for sends, 1 for hardware outputs
+ */
+void BaseSendInfo::saveSendState(int category, bool update) {
+    MediaTrack* track = getSrcTrack();
+    for (size_t i = 0; i < mParamInfo.namedCount(); i++) {
+        mParamInfo.setNamedValue(i, GetTrackSendInfo_Value(track, category, mSendIdx, mParamInfo.keyAt(i)));
+        if (!update)
+            mParamInfo.setNamedFilter(i, RECALLED);
+    }
+}
+
+/**
+ * Recalls all send parameters to the send at mSendIdx
+ * @param category 0 for sends, 1 for hardware outputs
+ */
+void BaseSendInfo::recallSendState(MediaTrack* track, int category) const {
+    for (size_t i = 0; i < mParamInfo.namedCount(); i++) {
+        g_lpe->mModel->mShadowState.setSendValue(track, category, mSendIdx, mParamInfo.keyAt(i),
+                                                 mParamInfo.namedValueAt(i));
+    }
 }
\ No newline at end of file
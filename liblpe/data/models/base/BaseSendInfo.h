@@ -31,6 +31,7 @@
 #define LPE_SENDINFO_H
 
 #include <liblpe/data/models/base/BaseInfo.h>
+#include <array>
 
 //define used parameters
 #define B_MUTE "B_MUTE"
@@ -55,6 +56,38 @@
 #define I_DSTCHAN "I_DSTCHAN"
 #define I_MIDIFLAGS "I_MIDIFLAGS"
 
+/**
+ * Named send parameters, indexes SEND_PARAM_KEYS and the parameters of a send
+ */
+enum class SendParam : uint8_t {
+    MUTE,
+    MONO,
+    PHASE,
+    VOL,
+    PAN,
+    PANLAW,
+    SENDMODE,
+    AUTOMODE,
+    SRCCHAN,
+    DSTCHAN,
+    MIDIFLAGS,
+    COUNT
+};
+
+constexpr std::array<const char*, (size_t) SendParam::COUNT> SEND_PARAM_KEYS = {
+        B_MUTE,
+        B_MONO,
+        B_PHASE,
+        D_VOL,
+        D_PAN,
+        D_PANLAW,
+        I_SENDMODE,
+        I_AUTOMODE,
+        I_SRCCHAN,
+        I_DSTCHAN,
+        I_MIDIFLAGS
+};
+
 class BaseSendInfo : public BaseInfo {
 public:
     explicit BaseSendInfo(Filterable* parent);
@@ -70,9 +103,10 @@ public:
     void recallSettings() const override;
     void saveCurrentState(bool update) override;
 protected:
-    bool initFromChunkHandler(std::string &key, std::vector<const char*> &params) override;
-    void persistHandler(WDL_FastString &str) const override;
-    [[nodiscard]] std::set<std::string> getKeys() const override;
+    bool initFromChunkHandler(std::string_view key, std::vector<const char*> &params) override;
+    void persistHandler(ChunkWriter &str) const override;
+    void saveSendState(int category, bool update);
+    void recallSendState(MediaTrack* track, int category) const;
     [[nodiscard]] virtual MediaTrack* getSrcTrack() const = 0;
 };
 
@@ -32,33 +32,50 @@
 #include <liblpe/data/models/FxInfo.h>
 #include <liblpe/data/models/HwSendInfo.h>
 #include <liblpe/data/models/SwSendInfo.h>
+#include <liblpe/data/models/RecallPlan.h>
 #include <reaper_plugin_functions.h>
 #include <liblpe/LivePresetsExtension.h>
 #include <liblpe/util/util.h>
 
 const GUID BaseTrackInfo::MASTER_GUID = GUID{0, 0, 0, 0};
 
-BaseTrackInfo::BaseTrackInfo(Filterable *parent) : BaseInfo(parent) {}
+static_assert((size_t) TrackParam::COUNT <= ParameterInfo::NAMED_CAPACITY);
+
+/**
+ * Returns the layout of the first count track parameters
+ */
+static const ParameterLayout* getParamLayout(size_t count) {
+    static const ParameterLayout master(TRACK_PARAM_KEYS, MASTER_PARAM_COUNT);
+    static const ParameterLayout track(TRACK_PARAM_KEYS, (size_t) TrackParam::COUNT);
+    return count == MASTER_PARAM_COUNT ? &master : &track;
+}
+
+/**
+ * @param paramCount the number of track parameters, MASTER_PARAM_COUNT or TrackParam::COUNT
+ */
+BaseTrackInfo::BaseTrackInfo(Filterable *parent, size_t paramCount) : BaseInfo(parent, getParamLayout(paramCount)) {}
 
 void BaseTrackInfo::saveCurrentState(bool update) {
+    MediaTrack* track = getMediaTrack();
 
     //get track settings
-    for (const auto& key : getKeys()) {
-        double val = GetMediaTrackInfo_Value(getMediaTrack(), key.data());
+    for (size_t i = 0; i < mParamInfo.namedCount(); i++) {
+        double value = GetMediaTrackInfo_Value(track, mParamInfo.keyAt(i));
 
 #ifndef _MACOS
         //mac scales different to linux and win on 4k screens, recall half the height and save double the height
-        if (key == I_HEIGHTOVERRIDE) {
-            val *= 2;
+        if (i == (size_t) TrackParam::HEIGHTOVERRIDE) {
+            value *= 2;
         }
 #endif
 
-        auto param = Parameter<double>(&mParamInfo, key, val, update ? mParamInfo.at(key).mFilter : RECALLED);
-        mParamInfo.insert(key, param);
+        mParamInfo.setNamedValue(i, value);
+        if (!update)
+            mParamInfo.setNamedFilter(i, RECALLED);
     }
 }
 
-bool BaseTrackInfo::initFromChunkHandler(std::string& key, ProjectStateContext* ctx) {
+bool BaseTrackInfo::initFromChunkHandler(std::string_view key, ProjectStateContext* ctx) {
     if (BaseInfo::initFromChunkHandler(key, ctx))
         return true;
 
@@ -73,11 +90,11 @@ bool BaseTrackInfo::initFromChunkHandler(std::string& key, ProjectStateContext*
     return false;
 }
 
-bool BaseTrackInfo::initFromChunkHandler(std::string& key, std::vector<const char*>& params) {
+bool BaseTrackInfo::initFromChunkHandler(std::string_view key, std::vector<const char*>& params) {
     if (BaseInfo::initFromChunkHandler(key, params))
         return true;
 
-    mParamInfo.insert(key, Parameter<double>(&mParamInfo, key, std::stod(params[0]), (FilterMode) std::stoi(params[1])));
+    mParamInfo.insert(key, ParseDouble(params[0]), (FilterMode) ParseInt(params[1]));
     return true;
 }
 
@@ -87,44 +104,83 @@ void BaseTrackInfo::recallSettings() const {
 
     //assign track settings, only change when needed
     //recall parameters
-    for (const auto& key : getKeys()) {
-        if (mParamInfo.at(key).isFilteredInChain())
+    MediaTrack* track = getMediaTrack();
+    for (size_t i = 0; i < mParamInfo.namedCount(); i++) {
+        if (mParamInfo.isNamedFilteredInChain(i))
             continue;
 
-        double value = mParamInfo.at(key).mValue;
+        //layout changes are deferred until the audible changes are done
+        const char* key = mParamInfo.keyAt(i);
+        if (RecallPlan::isLayoutKey(key))
+            g_lpe->mModel->setLayoutValue(track, key, getRecallValue((TrackParam) i));
+        else
+            g_lpe->mModel->mShadowState.setTrackValue(track, key, getRecallValue((TrackParam) i));
+    }
 
-#ifndef _MACOS
-        //mac scales different to linux and win on 4k screens, recall half the height and save double the height
-        if (key == I_HEIGHTOVERRIDE) {
-            value = value / 2;
-        }
-#endif
+    recallHwSends();
 
-        //override show tracks when global option is active
-        if (key == B_SHOWINTCP && g_lpe->mModel->mIsHideMutedTracks && mParamInfo.at(B_MUTE).mValue == 1) {
-            value = 0;
+    auto muted = (bool) mParamInfo.valueAt(TrackParam::MUTE);
+    if (!muted) {
+        for (auto *const fxInfo : mFxs) {
+            fxInfo->recallSettings();
         }
+    }
+}
 
-        if (GetMediaTrackInfo_Value(getMediaTrack(), key.data()) != value)
-            SetMediaTrackInfo_Value(getMediaTrack(), key.data(), value);
+/**
+ * Adds the unfiltered track settings, hw sends and fxs to the plan
+ */
+void BaseTrackInfo::compileRecall(RecallPlan& plan) const {
+    if (isFilteredInChain())
+        return;
+
+    MediaTrack* track = getMediaTrack();
+    for (size_t i = 0; i < mParamInfo.namedCount(); i++) {
+        if (!mParamInfo.isNamedFilteredInChain(i))
+            plan.addTrackValue(track, mParamInfo.keyAt(i), getRecallValue((TrackParam) i));
     }
 
-    recallHwSends();
+    plan.addHwSends(this);
 
-    auto muted = (bool) mParamInfo.at(B_MUTE).mValue;
+    auto muted = (bool) mParamInfo.valueAt(TrackParam::MUTE);
     if (!muted) {
         for (auto *const fxInfo : mFxs) {
-            fxInfo->recallSettings();
+            fxInfo->compileRecall(plan);
         }
     }
 }
 
+/**
+ * Returns the value that is written to the track when recalling the given key
+ */
+double BaseTrackInfo::getRecallValue(TrackParam key) const {
+    double value = mParamInfo.valueAt(key);
+
+#ifndef _MACOS
+    //mac scales different to linux and win on 4k screens, recall half the height and save double the height
+    if (key == TrackParam::HEIGHTOVERRIDE) {
+        value = value / 2;
+    }
+#endif
+
+    //override show tracks when global option is active
+    if (key == TrackParam::SHOWINTCP && g_lpe->mModel->mIsHideMutedTracks &&
+            mParamInfo.valueAt(TrackParam::MUTE) == 1) {
+        value = 0;
+    }
+    return value;
+}
+
 /**
  * All hw sends can be adepted to fit specific parameters so only make sure the count is matching
  */
 void BaseTrackInfo::recallHwSends() const {
+    RecallProfiler::Timer timer(RecallProfiler::SENDS);
     MediaTrack* track = getMediaTrack();
 
+    if (GetTrackNumSends(track, 1) != (int) mHwSends.size())
+        g_lpe->mModel->mShadowState.invalidateSends(track);
+
     while (GetTrackNumSends(track, 1) > (int) mHwSends.size())
         RemoveTrackSend(track, 1, 0);
 
@@ -139,7 +195,7 @@ void BaseTrackInfo::recallHwSends() const {
     }
 }
 
-void BaseTrackInfo::persistHandler(WDL_FastString &str) const {
+void BaseTrackInfo::persistHandler(ChunkWriter &str) const {
     BaseInfo::persistHandler(str);
 
     for (const auto& send : mHwSends) {
@@ -150,41 +206,10 @@ void BaseTrackInfo::persistHandler(WDL_FastString &str) const {
     }
 }
 
-std::set<std::string> BaseTrackInfo::getKeys() const {
-    auto set = BaseInfo::getKeys();
-    std::set<std::string> keys = {
-            B_MUTE,
-            I_SOLO,
-            I_FXEN,
-            I_AUTOMODE,
-            I_NCHAN,
-            I_SELECTED,
-            I_MIDIHWOUT,
-            I_PERFFLAGS,
-            I_CUSTOMCOLOR,
-            I_HEIGHTOVERRIDE,
-            B_HEIGHTLOCK,
-            D_VOL,
-            D_PAN,
-            D_WIDTH,
-            D_DUALPANL,
-            D_DUALPANR,
-            I_PANMODE,
-            D_PANLAW,
-            C_BEATATTACHMODE,
-            F_MCP_FXSEND_SCALE,
-            F_MCP_SENDRGN_SCALE
-    };
-    set.insert(keys.begin(), keys.end());
-    return set;
-}
-
 void BaseTrackInfo::saveHwSendState(Filterable *parent, std::vector<HwSendInfo *> &hwSends, MediaTrack *track,
                                     const GUID *guid, bool update) {
     if (update) {
         //search for matching output channels and resave these
-        auto savedHwSends = std::vector<HwSendInfo*>(hwSends);
-
         //first int is the dst channel, second int is the send index
         auto currentHwSends = std::vector<std::pair<int, int>>();
         for (int i = 0; i < GetTrackNumSends(track, 1); i++) {
@@ -192,35 +217,14 @@ void BaseTrackInfo::saveHwSendState(Filterable *parent, std::vector<HwSendInfo *
             currentHwSends.push_back(val);
         }
 
-        bool (*cmp)(HwSendInfo*&, std::pair<int, int>&) = [](HwSendInfo*& a, std::pair<int, int>& b) -> bool {
-            return a->mParamInfo.at(I_DSTCHAN).mValue == b.first;
-        };
-
-        auto hwSendsDelete = std::vector<HwSendInfo*>();
-        auto hwSendsNew = std::vector<std::pair<int, int>>();
-        auto hwSendsUpdate = std::vector<std::pair<HwSendInfo*, std::pair<int, int>>>();
-        compareVectors(savedHwSends, currentHwSends, hwSendsDelete, hwSendsNew, hwSendsUpdate, *cmp);
-
-        for (auto& hwSendUpdate : hwSendsUpdate) {
-            hwSendUpdate.first->mSendIdx = hwSendUpdate.second.second;
-            hwSendUpdate.first->saveCurrentState(update);
-        }
-
-        for (HwSendInfo* hwSendDelete : hwSendsDelete) {
-            int index = 0;
-            for (int i = 0; i < (int) hwSends.size(); i++) {
-                if (hwSends[i] == hwSendDelete) {
-                    index = i;
-                    break;
-                }
-            }
-            hwSends.erase(hwSends.begin() + index);
-        }
-
-        for (std::pair<int, int>& hwSendNew : hwSendsNew) {
-            auto *info = new HwSendInfo(parent, *guid, hwSendNew.second);
-            hwSends.push_back(info);
-        }
+        reconcile<int>(hwSends, currentHwSends,
+                [](HwSendInfo* a) -> int { return (int) a->mParamInfo.valueAt(SendParam::DSTCHAN); },
+                [](const std::pair<int, int>& b) -> int { return b.first; },
+                [update](HwSendInfo* a, const std::pair<int, int>& b) {
+                    a->mSendIdx = b.second;
+                    a->saveCurrentState(update);
+                },
+                [&](const std::pair<int, int>& b) { hwSends.push_back(new HwSendInfo(parent, *guid, b.second)); });
     } else {
         for (int i = 0; i < GetTrackNumSends(track, 1); i++) {
             auto *info = new HwSendInfo(parent, *guid, i);
@@ -232,9 +236,7 @@ void BaseTrackInfo::saveHwSendState(Filterable *parent, std::vector<HwSendInfo *
 void BaseTrackInfo::saveSwSendState(Filterable *parent, std::vector<SwSendInfo *> &swSends, MediaTrack *track,
                                     const GUID *guid, bool update) {
     if (update) {
-        //search for matching output channels and resave these
-        auto savedSwSends = std::vector<SwSendInfo*>(swSends);
-
+        //search for matching destination tracks and resave these
         auto currentSwSends = std::vector<std::pair<const GUID*, int>>();
         for (int i = 0; i < GetTrackNumSends(track, 0); i++) {
             auto dst = (long long) GetTrackSendInfo_Value(track, 0, i, P_DESTTRACK);
@@ -243,36 +245,16 @@ void BaseTrackInfo::saveSwSendState(Filterable *parent, std::vector<SwSendInfo *
             currentSwSends.push_back(val);
         }
 
-        bool (*cmp)(SwSendInfo*&, std::pair<const GUID*, int>&) =
-                [](SwSendInfo*& a, std::pair<const GUID*, int>& b) -> bool {
-            return GuidsEqual(a->mDstTrackGuid, *b.first);
-        };
-
-        auto swSendsDelete = std::vector<SwSendInfo*>();
-        auto swSendsNew = std::vector<std::pair<const GUID*, int>>();
-        auto swSendsUpdate = std::vector<std::pair<SwSendInfo*, std::pair<const GUID*, int>>>();
-        compareVectors(savedSwSends, currentSwSends, swSendsDelete, swSendsNew, swSendsUpdate, *cmp);
-
-        for (auto& swSendUpdate : swSendsUpdate) {
-            swSendUpdate.first->mSendIdx = swSendUpdate.second.second;
-            swSendUpdate.first->saveCurrentState(update);
-        }
-
-        for (SwSendInfo* swSendDelete : swSendsDelete) {
-            int index = 0;
-            for (int i = 0; i < (int) swSends.size(); i++) {
-                if (swSends[i] == swSendDelete) {
-                    index = i;
-                    break;
-                }
-            }
-            swSends.erase(swSends.begin() + index);
-        }
-
-        for (auto& swSendNew : swSendsNew) {
-            auto *info = new SwSendInfo(parent, *guid, swSendNew.second);
-            swSends.push_back(info);
-        }
+        reconcile<GUID, GuidHash, GuidEqual>(swSends, currentSwSends,
+                [](SwSendInfo* a) -> const GUID& { return a->mDstTrackGuid; },
+                [](const std::pair<const GUID*, int>& b) -> const GUID& { return *b.first; },
+                [update](SwSendInfo* a, const std::pair<const GUID*, int>& b) {
+                    a->mSendIdx = b.second;
+                    a->saveCurrentState(update);
+                },
+                [&](const std::pair<const GUID*, int>& b) {
+                    swSends.push_back(new SwSendInfo(parent, *guid, b.second));
+                });
     } else {
         for (int i = 0; i < GetTrackNumSends(track, 0); i++) {
             auto *info = new SwSendInfo(parent, *guid, i);
@@ -284,8 +266,6 @@ void BaseTrackInfo::saveSwSendState(Filterable *parent, std::vector<SwSendInfo *
 void BaseTrackInfo::saveFxState(Filterable *parent, std::vector<FxInfo *> &fxs, MediaTrack *track, const GUID *guid,
                                 bool update, bool rec) {
     if (update) {
-        auto savedFxs = std::vector<FxInfo*>(fxs);
-
         auto currentFxs = std::vector<const GUID*>();
         if (rec) {
             for (int i = FxInfo::RECFX_INDEX_FACTOR; i < FxInfo::RECFX_INDEX_FACTOR + TrackFX_GetRecCount(track); i++) {
@@ -297,34 +277,11 @@ void BaseTrackInfo::saveFxState(Filterable *parent, std::vector<FxInfo *> &fxs,
             }
         }
 
-        bool (*cmp)(FxInfo*&, const GUID*&) = [](FxInfo*& a, const GUID*& b) -> bool {
-            return GuidsEqual(a->mGuid, *b);
-        };
-
-        auto fxsDelete = std::vector<FxInfo*>();
-        auto fxsNew = std::vector<const GUID*>();
-        auto fxsUpdate = std::vector<std::pair<FxInfo*, const GUID*>>();
-        compareVectors(savedFxs, currentFxs, fxsDelete, fxsNew, fxsUpdate, *cmp);
-
-        for (auto& fxUpdate : fxsUpdate) {
-            fxUpdate.first->saveCurrentState(update);
-        }
-
-        for (FxInfo* fxDelete : fxsDelete) {
-            int index = 0;
-            for (int i = 0; i < (int) fxs.size(); i++) {
-                if (fxs[i] == fxDelete) {
-                    index = i;
-                    break;
-                }
-            }
-            fxs.erase(fxs.begin() + index);
-        }
-
-        for (const GUID* fxNew : fxsNew) {
-            auto *info = new FxInfo(parent, *guid, *fxNew);
-            fxs.push_back(info);
-        }
+        reconcile<GUID, GuidHash, GuidEqual>(fxs, currentFxs,
+                [](FxInfo* a) -> const GUID& { return a->mGuid; },
+                [](const GUID* b) -> const GUID& { return *b; },
+                [update](FxInfo* a, const GUID*) { a->saveCurrentState(update); },
+                [&](const GUID* b) { fxs.push_back(new FxInfo(parent, *guid, *b)); });
     } else {
         if (rec) {
             for (int i = FxInfo::RECFX_INDEX_FACTOR; i < FxInfo::RECFX_INDEX_FACTOR + TrackFX_GetRecCount(track); i++) {
@@ -56,12 +56,107 @@
 #define C_BEATATTACHMODE "C_BEATATTACHMODE"
 #define F_MCP_FXSEND_SCALE "F_MCP_FXSEND_SCALE"
 #define F_MCP_SENDRGN_SCALE "F_MCP_SENDRGN_SCALE"
+#define B_PHASE "B_PHASE"
+#define I_RECARM "I_RECARM"
+#define I_RECINPUT "I_RECINPUT"
+#define I_RECMODE "I_RECMODE"
+#define I_RECMON "I_RECMON"
+#define I_RECMONITEMS "I_RECMONITEMS"
+#define I_FOLDERDEPTH "I_FOLDERDEPTH"
+#define I_FOLDERCOMPACT "I_FOLDERCOMPACT"
+#define B_SHOWINMIXER "B_SHOWINMIXER"
+#define B_SHOWINTCP "B_SHOWINTCP"
+#define B_MAINSEND "B_MAINSEND"
+#define C_MAINSEND_OFFS "C_MAINSEND_OFFS"
+#define B_FREEMODE "B_FREEMODE"
+
+/**
+ * Named track parameters, indexes TRACK_PARAM_KEYS and the parameters of a track
+ * The master track uses the parameters before MASTER_PARAM_COUNT
+ */
+enum class TrackParam : uint8_t {
+    MUTE,
+    SOLO,
+    FXEN,
+    AUTOMODE,
+    NCHAN,
+    SELECTED,
+    MIDIHWOUT,
+    PERFFLAGS,
+    CUSTOMCOLOR,
+    HEIGHTOVERRIDE,
+    HEIGHTLOCK,
+    VOL,
+    PAN,
+    WIDTH,
+    DUALPANL,
+    DUALPANR,
+    PANMODE,
+    PANLAW,
+    BEATATTACHMODE,
+    MCP_FXSEND_SCALE,
+    MCP_SENDRGN_SCALE,
+    //normal tracks only
+    PHASE,
+    RECARM,
+    RECINPUT,
+    RECMODE,
+    RECMON,
+    RECMONITEMS,
+    FOLDERDEPTH,
+    FOLDERCOMPACT,
+    SHOWINMIXER,
+    SHOWINTCP,
+    MAINSEND,
+    MAINSEND_OFFS,
+    FREEMODE,
+    COUNT
+};
+
+constexpr size_t MASTER_PARAM_COUNT = (size_t) TrackParam::PHASE;
+
+constexpr std::array<const char*, (size_t) TrackParam::COUNT> TRACK_PARAM_KEYS = {
+        B_MUTE,
+        I_SOLO,
+        I_FXEN,
+        I_AUTOMODE,
+        I_NCHAN,
+        I_SELECTED,
+        I_MIDIHWOUT,
+        I_PERFFLAGS,
+        I_CUSTOMCOLOR,
+        I_HEIGHTOVERRIDE,
+        B_HEIGHTLOCK,
+        D_VOL,
+        D_PAN,
+        D_WIDTH,
+        D_DUALPANL,
+        D_DUALPANR,
+        I_PANMODE,
+        D_PANLAW,
+        C_BEATATTACHMODE,
+        F_MCP_FXSEND_SCALE,
+        F_MCP_SENDRGN_SCALE,
+        B_PHASE,
+        I_RECARM,
+        I_RECINPUT,
+        I_RECMODE,
+        I_RECMON,
+        I_RECMONITEMS,
+        I_FOLDERDEPTH,
+        I_FOLDERCOMPACT,
+        B_SHOWINMIXER,
+        B_SHOWINTCP,
+        B_MAINSEND,
+        C_MAINSEND_OFFS,
+        B_FREEMODE
+};
 
 class BaseTrackInfo : public BaseInfo {
 public:
     static const GUID MASTER_GUID;
 
-    BaseTrackInfo(Filterable* parent);
+    BaseTrackInfo(Filterable* parent, size_t paramCount);
     ~BaseTrackInfo();
 
     //data to persist
@@ -71,13 +166,14 @@ public:
 
     void recallSettings() const override;
     void saveCurrentState(bool update) override;
+    virtual void compileRecall(RecallPlan& plan) const;
+    void recallHwSends() const;
 protected:
-    [[nodiscard]] std::set<std::string> getKeys() const override;
-    bool initFromChunkHandler(std::string& key, std::vector<const char*>& params) override;
-    bool initFromChunkHandler(std::string& key, ProjectStateContext *ctx) override;
-    void persistHandler(WDL_FastString &str) const override;
+    bool initFromChunkHandler(std::string_view key, std::vector<const char*>& params) override;
+    bool initFromChunkHandler(std::string_view key, ProjectStateContext *ctx) override;
+    void persistHandler(ChunkWriter &str) const override;
     [[nodiscard]] virtual MediaTrack* getMediaTrack() const = 0;
-    void recallHwSends() const;
+    [[nodiscard]] double getRecallValue(TrackParam key) const;
     static void saveSwSendState(Filterable *parent, std::vector<SwSendInfo *> &swSends, MediaTrack *track,
             const GUID *guid, bool update);
     static void saveHwSendState(Filterable *parent, std::vector<HwSendInfo *> &hwSends, MediaTrack *track,
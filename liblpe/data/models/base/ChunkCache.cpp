@@ -0,0 +1,87 @@
+/******************************************************************************
+/ LivePresetsExtension
+/
+/ Keeps the serialized chunk of an object between saves
+/
+/ Copyright (c) 2020 and later Dr. med. Frederik Bertling
+/
+/
+/ Permission is hereby granted, free of charge, to any person obtaining a copy
+/ of this software and associated documentation files (the "Software"), to deal
+/ in the Software without restriction, including without limitation the rights to
+/ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+/ of the Software, and to permit persons to whom the Software is furnished to
+/ do so, subject to the following conditions:
+/
+/ The above copyright notice and this permission notice shall be included in all
+/ copies or substantial portions of the Software.
+/
+/ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+/ EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+/ OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+/ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+/ HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+/ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/ FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+/ OTHER DEALINGS IN THE SOFTWARE.
+/
+******************************************************************************/
+
+#include <liblpe/data/models/base/ChunkCache.h>
+#include <liblpe/data/models/base/Persistable.h>
+#include <liblpe/util/ChunkCodec.h>
+#include <functional>
+
+/**
+ * Writes the cached chunk of obj, it is serialized first when it changed since the last call
+ */
+void ChunkCache::persist(const Persistable& obj, ChunkWriter& str) const {
+    update(obj);
+    str.Append(mChunk.Get());
+}
+
+/**
+ * Writes the cached chunk of obj as binary ChunkCodec lines, it is encoded again only when obj changed
+ */
+void ChunkCache::persistEncoded(const Persistable& obj, ChunkWriter& str) const {
+    update(obj);
+    if (!mIsEncodedValid) {
+        std::string data;
+        std::string base64;
+        ChunkCodec::encode(std::string_view(mChunk.Get(), mChunk.GetLength()), data);
+        ChunkCodec::encodeBase64(data, base64);
+        mEncodedChunk.clear();
+        ChunkCodec::appendLines(ChunkCodec::VERSION, base64, mEncodedChunk);
+        mIsEncodedValid = true;
+    }
+    str.Append(mEncodedChunk.c_str());
+}
+
+/**
+ * Compares the chunk of obj with a chunk read from a project state, the hashes reject most differing chunks without
+ * comparing them
+ * @param hash getHash() of chunk
+ */
+bool ChunkCache::isEqual(const Persistable& obj, std::string_view chunk, size_t hash) const {
+    update(obj);
+    return mHash == hash && std::string_view(mChunk.Get(), mChunk.GetLength()) == chunk;
+}
+
+void ChunkCache::invalidate() {
+    mIsValid = false;
+}
+
+size_t ChunkCache::getHash(std::string_view chunk) {
+    return std::hash<std::string_view>()(chunk);
+}
+
+void ChunkCache::update(const Persistable& obj) const {
+    if (mIsValid)
+        return;
+
+    mChunk.Set("");
+    obj.persist(mChunk);
+    mHash = getHash(std::string_view(mChunk.Get(), mChunk.GetLength()));
+    mIsValid = true;
+    mIsEncodedValid = false;
+}
\ No newline at end of file
@@ -0,0 +1,63 @@
+/******************************************************************************
+/ LivePresetsExtension
+/
+/ Keeps the serialized chunk of an object between saves
+/
+/ Copyright (c) 2020 and later Dr. med. Frederik Bertling
+/
+/
+/ Permission is hereby granted, free of charge, to any person obtaining a copy
+/ of this software and associated documentation files (the "Software"), to deal
+/ in the Software without restriction, including without limitation the rights to
+/ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+/ of the Software, and to permit persons to whom the Software is furnished to
+/ do so, subject to the following conditions:
+/
+/ The above copyright notice and this permission notice shall be included in all
+/ copies or substantial portions of the Software.
+/
+/ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+/ EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+/ OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+/ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+/ HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+/ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/ FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+/ OTHER DEALINGS IN THE SOFTWARE.
+/
+******************************************************************************/
+
+#ifndef LPE_CHUNKCACHE_H
+#define LPE_CHUNKCACHE_H
+
+#include <string>
+#include <string_view>
+#include <liblpe/data/models/base/ChunkWriter.h>
+
+class Persistable;
+
+/**
+ * Chunk of a Persistable that is reused by every save and undo point until the object changes and invalidate() is
+ * called, so only changed objects are serialized again
+ */
+class ChunkCache {
+public:
+    void persist(const Persistable& obj, ChunkWriter& str) const;
+    void persistEncoded(const Persistable& obj, ChunkWriter& str) const;
+    [[nodiscard]] bool isEqual(const Persistable& obj, std::string_view chunk, size_t hash) const;
+    void invalidate();
+
+    [[nodiscard]] static size_t getHash(std::string_view chunk);
+private:
+    mutable WDL_FastString mChunk;
+    mutable size_t mHash = 0;
+    mutable bool mIsValid = false;
+    //ChunkCodec lines of mChunk, encoded on the first persistEncoded() after a change
+    mutable std::string mEncodedChunk;
+    mutable bool mIsEncodedValid = false;
+
+    void update(const Persistable& obj) const;
+};
+
+
+#endif //LPE_CHUNKCACHE_H
\ No newline at end of file
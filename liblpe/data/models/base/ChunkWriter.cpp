@@ -0,0 +1,75 @@
+/******************************************************************************
+/ LivePresetsExtension
+/
+/ Writes persisted chunks line by line
+/
+/ Copyright (c) 2020 and later Dr. med. Frederik Bertling
+/
+/
+/ Permission is hereby granted, free of charge, to any person obtaining a copy
+/ of this software and associated documentation files (the "Software"), to deal
+/ in the Software without restriction, including without limitation the rights to
+/ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+/ of the Software, and to permit persons to whom the Software is furnished to
+/ do so, subject to the following conditions:
+/
+/ The above copyright notice and this permission notice shall be included in all
+/ copies or substantial portions of the Software.
+/
+/ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+/ EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+/ OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+/ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+/ HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+/ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/ FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+/ OTHER DEALINGS IN THE SOFTWARE.
+/
+******************************************************************************/
+
+#include <cstdarg>
+#include <cstdio>
+#include <liblpe/data/models/base/ChunkWriter.h>
+
+ChunkWriter::ChunkWriter(WDL_FastString& str) : mStr(&str) {}
+
+ChunkWriter::ChunkWriter(ProjectStateContext* ctx) : mCtx(ctx) {}
+
+/**
+ * Passes an unterminated last line to the context
+ */
+ChunkWriter::~ChunkWriter() {
+    if (mCtx && !mLine.empty())
+        mCtx->AddLine("%s", mLine.data());
+}
+
+void ChunkWriter::Append(const char* str) {
+    if (mStr) {
+        mStr->Append(str);
+        return;
+    }
+
+    const char* start = str;
+    while (const char* end = strchr(start, '\n')) {
+        mLine.append(start, end - start);
+        mCtx->AddLine("%s", mLine.data());
+        mLine.clear();
+        start = end + 1;
+    }
+    mLine.append(start);
+}
+
+/**
+ * Formats like printf, the result is truncated to maxLen - 1 chars
+ */
+void ChunkWriter::AppendFormatted(int maxLen, const char* format, ...) {
+    if (mFormatted.size() < (size_t) maxLen)
+        mFormatted.resize(maxLen);
+
+    va_list args;
+    va_start(args, format);
+    vsnprintf(mFormatted.data(), maxLen, format, args);
+    va_end(args);
+
+    Append(mFormatted.data());
+}
\ No newline at end of file
@@ -0,0 +1,63 @@
+/******************************************************************************
+/ LivePresetsExtension
+/
+/ Writes persisted chunks line by line
+/
+/ Copyright (c) 2020 and later Dr. med. Frederik Bertling
+/
+/
+/ Permission is hereby granted, free of charge, to any person obtaining a copy
+/ of this software and associated documentation files (the "Software"), to deal
+/ in the Software without restriction, including without limitation the rights to
+/ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+/ of the Software, and to permit persons to whom the Software is furnished to
+/ do so, subject to the following conditions:
+/
+/ The above copyright notice and this permission notice shall be included in all
+/ copies or substantial portions of the Software.
+/
+/ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+/ EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+/ OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+/ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+/ HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+/ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/ FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+/ OTHER DEALINGS IN THE SOFTWARE.
+/
+******************************************************************************/
+
+#ifndef LPE_CHUNKWRITER_H
+#define LPE_CHUNKWRITER_H
+
+#include <string>
+#include <vector>
+#include <cstring> //needed for WDL/wdlstring
+#include <wdlstring.h>
+#include <reaper_plugin.h>
+
+/**
+ * Target of Persistable::persist. The chunk is either appended to a string or passed line by line to a
+ * ProjectStateContext, so saving a project never holds the whole chunk in memory. The methods are named like the ones
+ * of WDL_FastString which was written to before
+ */
+class ChunkWriter {
+public:
+    explicit ChunkWriter(WDL_FastString& str);
+    explicit ChunkWriter(ProjectStateContext* ctx);
+    ChunkWriter(const ChunkWriter& other) = delete;
+    ChunkWriter& operator=(const ChunkWriter& other) = delete;
+    ~ChunkWriter();
+
+    void Append(const char* str);
+    void AppendFormatted(int maxLen, const char* format, ...);
+private:
+    WDL_FastString* mStr = nullptr;
+    ProjectStateContext* mCtx = nullptr;
+    //the unfinished line and the formatting buffer keep their capacity, so writing a line does not allocate
+    std::string mLine;
+    std::vector<char> mFormatted;
+};
+
+
+#endif //LPE_CHUNKWRITER_H
\ No newline at end of file
@@ -31,23 +31,74 @@
 
 Filterable::Filterable(Filterable* parent, FilterMode mFilter) : mFilter(mFilter), mParent(parent) {}
 
+/**
+ * Copies filter and parent, the cached chain filter is not copied as the copy may get another parent
+ */
+Filterable::Filterable(const Filterable& other) : mFilter(other.mFilter), mParent(other.mParent) {}
+
+Filterable& Filterable::operator=(const Filterable& other) {
+    mFilter = other.mFilter;
+    mParent = other.mParent;
+    mRootGeneration = nullptr;
+    mChainGeneration = 0;
+    return *this;
+}
+
 /**
  * Checks the parent filter chain for RECALLED and IGNORED filters
  * The highest order RECALLED or IGNORED filter defines child behaviour
  * @return true when the param is filtered (IGNORED)
  */
 bool Filterable::isFilteredInChain() const {
-    FilterMode filter = mFilter;
-    Filterable* parent = mParent;
-    while (parent != nullptr) {
-        filter = MergeUpstream(parent->mFilter, filter);
-        parent = parent->mParent;
+    return getChainFilter() == IGNORED;
+}
+
+/**
+ * Resolves the filter chain once and caches the result until invalidateFilters() is called on the same tree
+ * @return the highest order RECALLED or IGNORED filter, or CHILD when there is none
+ */
+FilterMode Filterable::getChainFilter() const {
+    if (!mRootGeneration || mChainGeneration != *mRootGeneration) {
+        FilterMode parentFilter = CHILD;
+        if (mParent != nullptr) {
+            parentFilter = mParent->getChainFilter();
+            mRootGeneration = mParent->mRootGeneration;
+        } else {
+            mRootGeneration = &mFilterGeneration;
+        }
+        mChainFilter = MergeUpstream(parentFilter, mFilter);
+        mChainGeneration = *mRootGeneration;
     }
-    return filter == IGNORED;
+    return mChainFilter;
+}
+
+/**
+ * Has to be called after filters of existing objects were changed. The cached chain filters of the tree this object
+ * belongs to are resolved again, other presets keep theirs
+ */
+void Filterable::invalidateFilters() {
+    Filterable* root = this;
+    while (root->mParent != nullptr) {
+        root = root->mParent;
+    }
+    root->mFilterGeneration++;
+}
+
+/**
+ * @return the filter generation of the tree this object belongs to
+ */
+unsigned int Filterable::getFilterGeneration() const {
+    //resolving the chain sets mRootGeneration
+    (void) getChainFilter();
+    return *mRootGeneration;
 }
 
 std::string Filterable::getFilterText() const {
-    switch (mFilter) {
+    return GetFilterText(mFilter);
+}
+
+std::string Filterable::GetFilterText(FilterMode filter) {
+    switch (filter) {
         case RECALLED:
             return "[R]";
         case IGNORED:
@@ -85,4 +136,5 @@ void Filterable::shuffleFilter(bool noChild) {
             mFilter = RECALLED;
             break;
     }
+    invalidateFilters();
 }
\ No newline at end of file
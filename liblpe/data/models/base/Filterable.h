@@ -59,6 +59,8 @@ public:
     static FilterMode Merge(int num...);
 
     explicit Filterable(Filterable* parent, FilterMode mFilter = CHILD);
+    Filterable(const Filterable& other);
+    Filterable& operator=(const Filterable& other);
 
     FilterMode mFilter = CHILD;
     Filterable* mParent = nullptr;
@@ -68,10 +70,23 @@ public:
     virtual bool applyFilterPreset(FilterPreset *preset) = 0;
     [[nodiscard]] virtual char *getTreeText() const = 0;
     [[nodiscard]] bool isFilteredInChain() const;
+    void invalidateFilters();
 protected:
     mutable char mTreeText[256] = {};
     [[nodiscard]] std::string getFilterText() const;
+    [[nodiscard]] static std::string GetFilterText(FilterMode filter);
+    [[nodiscard]] FilterMode getChainFilter() const;
+    [[nodiscard]] unsigned int getFilterGeneration() const;
 private:
+    //counts the filter changes of the tree below this object, only used when it has no parent (a preset)
+    //starts at 1 that objects with mChainGeneration 0 are never valid
+    unsigned int mFilterGeneration = 1;
+
+    //cached result of getChainFilter, valid while mChainGeneration matches the generation of the root
+    mutable const unsigned int* mRootGeneration = nullptr;
+    mutable unsigned int mChainGeneration = 0;
+    mutable FilterMode mChainFilter = CHILD;
+
     static FilterMode MergeUpstream(FilterMode a, FilterMode b);
 };
 
@@ -28,57 +28,257 @@
 ******************************************************************************/
 
 #include <utility>
-#include <set>
+#include <cctype>
 #include <liblpe/data/models/base/ParameterInfo.h>
 #include <liblpe/data/models/FilterPreset.h>
+#include <liblpe/util/util.h>
 
-ParameterInfo::ParameterInfo(Filterable* parent) : Filterable(parent)
-{}
+ParameterLayout::ParameterLayout(std::span<const char* const> keys, size_t count) {
+    mKeys.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        mKeys.push_back(InternString(keys[i]));
+        mIndices.emplace(mKeys.back(), (int) i);
+    }
+}
+
+/**
+ * @return the index of key or -1 when it is not part of the layout
+ */
+int ParameterLayout::find(std::string_view key) const {
+    auto it = mIndices.find(key);
+    return it != mIndices.end() ? it->second : -1;
+}
 
-ParameterInfo::ParameterInfo(Filterable* parent, ProjectStateContext* ctx) : Filterable(parent) {
+/**
+ * @param layout the named parameters, nullptr for fx parameters
+ */
+ParameterInfo::ParameterInfo(Filterable* parent, const ParameterLayout* layout) : Filterable(parent),
+        mLayout(layout) {}
+
+ParameterInfo::ParameterInfo(Filterable* parent, ProjectStateContext* ctx) : Filterable(parent), mLayout(nullptr) {
     initFromChunk(ctx);
 }
 
-void ParameterInfo::insert(const std::string& key, const Parameter<double>& value) {
-    mParams.erase(key);
-    mParams.insert(std::make_pair(key, value));
+ParameterInfo::ParameterInfo(const ParameterInfo& other) : Filterable(other), Persistable(other),
+        mLayout(other.mLayout), mNamedValues(other.mNamedValues), mNamedFilters(other.mNamedFilters),
+        mUnknown(other.mUnknown), mValues(other.mValues), mFilters(other.mFilters), mIndexedSize(other.mIndexedSize) {
+    //the copy may have another parent, resolve the filters again
+    mFilteredGeneration = 0;
+}
+
+/**
+ * Copies the parameters but keeps the parent of this object
+ */
+ParameterInfo& ParameterInfo::operator=(const ParameterInfo& other) {
+    mFilter = other.mFilter;
+    mLayout = other.mLayout;
+    mNamedValues = other.mNamedValues;
+    mNamedFilters = other.mNamedFilters;
+    mUnknown = other.mUnknown;
+    mValues = other.mValues;
+    mFilters = other.mFilters;
+    mIndexedSize = other.mIndexedSize;
+    mFilteredGeneration = 0;
+    return *this;
+}
+
+size_t ParameterInfo::namedCount() const {
+    return mLayout ? mLayout->size() : 0;
+}
+
+const char* ParameterInfo::keyAt(size_t index) const {
+    return mLayout->keyAt(index);
+}
+
+/**
+ * @return the value of a named parameter, its address identifies the parameter in the tree view
+ */
+const double& ParameterInfo::namedValueAt(size_t index) const {
+    return mNamedValues[index];
+}
+
+FilterMode ParameterInfo::namedFilterAt(size_t index) const {
+    return (FilterMode) mNamedFilters[index];
+}
+
+void ParameterInfo::setNamedValue(size_t index, double value) {
+    mNamedValues[index] = value;
+}
+
+void ParameterInfo::setNamedFilter(size_t index, FilterMode filter) {
+    mNamedFilters[index] = (uint8_t) filter;
+}
+
+/**
+ * @return true when the named parameter must not be recalled
+ */
+bool ParameterInfo::isNamedFilteredInChain(size_t index) const {
+    //the highest order RECALLED or IGNORED filter defines the parameter behaviour
+    FilterMode chainFilter = getChainFilter();
+    return (chainFilter != CHILD ? chainFilter : (FilterMode) mNamedFilters[index]) == IGNORED;
+}
+
+/**
+ * Toggles a named parameter between RECALLED and IGNORED like Parameter::shuffleFilter(true)
+ * Named parameters are resolved on every check, nothing else of the preset has to be resolved again
+ */
+void ParameterInfo::shuffleNamedFilter(size_t index) {
+    mNamedFilters[index] = mNamedFilters[index] == IGNORED ? RECALLED : IGNORED;
+}
+
+/**
+ * Text of a named parameter in the tree view, formatted like the one of Parameter<double>
+ */
+std::string ParameterInfo::getNamedTreeText(size_t index) const {
+    std::string text = GetFilterText((FilterMode) mNamedFilters[index]) + " " + keyAt(index);
+    if (!isNamedFilteredInChain(index))
+        text += " = " + std::to_string(mNamedValues[index]);
+    return text;
+}
+
+/**
+ * Sets a named parameter, keys that are not part of the layout are kept to be persisted again
+ */
+void ParameterInfo::insert(std::string_view key, double value, FilterMode filter) {
+    int index = mLayout ? mLayout->find(key) : -1;
+    if (index >= 0) {
+        mNamedValues[index] = value;
+        mNamedFilters[index] = (uint8_t) filter;
+        return;
+    }
+
+    for (auto& param : mUnknown) {
+        if (param.key == key) {
+            param.value = value;
+            param.filter = filter;
+            return;
+        }
+    }
+    mUnknown.push_back({std::string(key), value, filter});
 }
 
 void ParameterInfo::insert(int key, const Parameter<double> &value) {
-    insert(std::to_string(key), value);
+    insert(key, value.mValue, value.mFilter);
+}
+
+void ParameterInfo::insert(int key, double value, FilterMode filter) {
+    if (key >= indexCount()) {
+        mValues.resize(key + 1, 0);
+        mFilters.resize(key + 1, MISSING);
+    }
+    if (mFilters[key] == MISSING)
+        mIndexedSize++;
+    mValues[key] = value;
+    mFilters[key] = (uint8_t) filter;
+    mFilteredGeneration = 0;
+}
+
+/**
+ * @return the value of an indexed parameter, its address identifies the parameter in the tree view
+ */
+const double& ParameterInfo::valueAt(int key) const {
+    return mValues.at(key);
+}
+
+FilterMode ParameterInfo::filterAt(int key) const {
+    return (FilterMode) mFilters.at(key);
 }
 
-const Parameter<double>& ParameterInfo::at(const std::string& key) const {
-    return mParams.at(key);
+/**
+ * Toggles an indexed parameter between RECALLED and IGNORED like Parameter::shuffleFilter(true)
+ * Only the filters of this container are resolved again
+ */
+void ParameterInfo::shuffleParamFilter(int key) {
+    mFilters.at(key) = mFilters[key] == IGNORED ? RECALLED : IGNORED;
+    mFilteredGeneration = 0;
 }
 
-const Parameter<double>& ParameterInfo::at(int key) const {
-    return at(std::to_string(key));
+/**
+ * Text of an indexed parameter in the tree view, formatted like the one of Parameter<double>
+ */
+std::string ParameterInfo::getParamTreeText(int key) const {
+    std::string text = GetFilterText(filterAt(key)) + " " + std::to_string(key);
+    if (!isFilteredInChain(key))
+        text += " = " + std::to_string(mValues[key]);
+    return text;
+}
+
+/**
+ * Checks the filter chain of an indexed parameter, missing parameters are always filtered
+ * @return true when the parameter must not be recalled
+ */
+bool ParameterInfo::isFilteredInChain(int key) const {
+    if (key < 0 || key >= indexCount())
+        return true;
+
+    if (mFilteredGeneration != getFilterGeneration())
+        resolveFilters();
+    return mFiltered[key];
+}
+
+/**
+ * Resolves the filter chain of all indexed parameters at once
+ */
+void ParameterInfo::resolveFilters() const {
+    //the highest order RECALLED or IGNORED filter defines the parameter behaviour
+    FilterMode chainFilter = getChainFilter();
+    mFiltered.assign(mFilters.size(), true);
+    for (size_t i = 0; i < mFilters.size(); i++) {
+        if (mFilters[i] == MISSING)
+            continue;
+        FilterMode filter = chainFilter != CHILD ? chainFilter : (FilterMode) mFilters[i];
+        mFiltered[i] = filter == IGNORED;
+    }
+    mFilteredGeneration = getFilterGeneration();
+}
+
+/**
+ * @return one past the highest index of the indexed parameters
+ */
+int ParameterInfo::indexCount() const {
+    return (int) mValues.size();
 }
 
 int ParameterInfo::size() const {
-    return (int) mParams.size();
+    return (int) (namedCount() + mUnknown.size()) + mIndexedSize;
 }
 
 void ParameterInfo::clear() {
-    mParams.clear();
+    mValues.clear();
+    mFilters.clear();
+    mIndexedSize = 0;
+    mFilteredGeneration = 0;
 }
 
-void ParameterInfo::persistHandler(WDL_FastString &str) const {
-    for (const auto& pair : mParams) {
-        const auto& param = pair.second;
-        str.AppendFormatted(4096, (pair.first + " %.17f %i\n").data(), param.mValue, param.mFilter);
+void ParameterInfo::persistHandler(ChunkWriter &str) const {
+    char value[32];
+    for (size_t i = 0; i < namedCount(); i++) {
+        FormatDouble(mNamedValues[i], value, sizeof(value));
+        str.AppendFormatted(4096, "%s %s %i\n", keyAt(i), value, mNamedFilters[i]);
+    }
+    for (const auto& param : mUnknown) {
+        FormatDouble(param.value, value, sizeof(value));
+        str.AppendFormatted(4096, "%s %s %i\n", param.key.data(), value, param.filter);
+    }
+
+    for (int i = 0; i < indexCount(); i++) {
+        if (mFilters[i] != MISSING) {
+            FormatDouble(mValues[i], value, sizeof(value));
+            str.AppendFormatted(4096, "%i %s %i\n", i, value, mFilters[i]);
+        }
     }
 
     str.AppendFormatted(4096, "FILTERMODE %u\n", mFilter);
 }
 
-bool ParameterInfo::initFromChunkHandler(std::string &key, std::vector<const char*> &params) {
-    if (key == "FILTERMODE") {
-        mFilter = (FilterMode) std::stoi(params[0]);
+bool ParameterInfo::initFromChunkHandler(std::string_view key, std::vector<const char*> &params) {
+    //indexed parameters make up most of the lines, check them first
+    if (isdigit(key[0])) {
+        insert(ParseInt(key.data()), ParseDouble(params[0]), (FilterMode) ParseInt(params[1]));
+    } else if (key == "FILTERMODE") {
+        mFilter = (FilterMode) ParseInt(params[0]);
     } else {
-        auto value = Parameter<double>(this, key, std::stod(params[0]), (FilterMode) std::stoi(params[1]));
-        mParams.insert(std::make_pair(key, value));
+        insert(key, ParseDouble(params[0]), (FilterMode) ParseInt(params[1]));
     }
     return true;
 }
@@ -94,24 +294,24 @@ std::string ParameterInfo::getChunkId() const {
     return "PARAMETERINFO";
 }
 
-std::vector<std::string> ParameterInfo::getKeys() {
-    std::vector<std::string> retval;
-    for (auto const& element : mParams) {
-        retval.push_back(element.first);
-    }
-    return retval;
-}
-
 bool ParameterInfo::keyExists(int key) const {
-    auto it = mParams.find(std::to_string(key));
-    return it != mParams.end();
+    return key >= 0 && key < indexCount() && mFilters[key] != MISSING;
 }
 
 FilterPreset* ParameterInfo::extractFilterPreset() {
     FilterPreset::ItemIdentifier id{};
     auto childs = std::vector<FilterPreset*>();
-    for (auto param : mParams) {
-        childs.push_back(param.second.extractFilterPreset());
+    for (size_t i = 0; i < namedCount(); i++) {
+        FilterPreset::ItemIdentifier paramId{};
+        paramId.key = keyAt(i);
+        childs.push_back(new FilterPreset(paramId, PARAM, (FilterMode) mNamedFilters[i]));
+    }
+    for (int i = 0; i < indexCount(); i++) {
+        if (mFilters[i] == MISSING)
+            continue;
+        FilterPreset::ItemIdentifier paramId{};
+        paramId.key = std::to_string(i);
+        childs.push_back(new FilterPreset(paramId, PARAM, (FilterMode) mFilters[i]));
     }
     return new FilterPreset(id, PARAMS, mFilter, childs);
 }
@@ -120,19 +320,25 @@ bool ParameterInfo::applyFilterPreset(FilterPreset *preset) {
     if (preset->mType == PARAMS) {
         mFilter = preset->mFilter;
 
-        auto toFilters = std::set<Filterable*>();
-        for (const auto& param : mParams) {
-            toFilters.insert((Filterable*) &param.second);
-        }
-
+        //parameters are addressed directly, the first preset of a key wins like it did with the preset index
+        std::array<bool, NAMED_CAPACITY> isApplied{};
         for (auto* child : preset->mChilds) {
-            for (auto* toFilter : toFilters) {
-                if (toFilter->applyFilterPreset(child)) {
-                    toFilters.erase(toFilter);
-                    goto cnt;
+            if (child->mType != PARAM || child->mId.key.empty())
+                continue;
+
+            if (isdigit(child->mId.key[0])) {
+                int key = ParseInt(child->mId.key.data());
+                if (keyExists(key)) {
+                    mFilters[key] = (uint8_t) child->mFilter;
+                    mFilteredGeneration = 0;
+                }
+            } else {
+                int index = mLayout ? mLayout->find(child->mId.key) : -1;
+                if (index >= 0 && !isApplied[index]) {
+                    mNamedFilters[index] = (uint8_t) child->mFilter;
+                    isApplied[index] = true;
                 }
             }
-            cnt:;
         }
         return true;
     }
@@ -33,20 +33,68 @@
 
 #include <liblpe/data/models/base/Parameter.h>
 #include <liblpe/data/models/base/Persistable.h>
-#include <map>
+#include <array>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
 
+/**
+ * The interned keys of a key table and their indices, built once per table. Keys of a chunk are looked up by hash.
+ */
+class ParameterLayout {
+public:
+    ParameterLayout(std::span<const char* const> keys, size_t count);
+
+    [[nodiscard]] size_t size() const { return mKeys.size(); }
+    [[nodiscard]] const char* keyAt(size_t index) const { return mKeys[index]; }
+    [[nodiscard]] int find(std::string_view key) const;
+private:
+    std::vector<const char*> mKeys;
+    std::unordered_map<std::string_view, int> mIndices;
+};
+
+/**
+ * Named parameters (track and send values) have a fixed layout given by a key table. Their values and filters are
+ * fixed-size arrays indexed by the key enum.
+ * Indexed parameters (fx parameters) are stored densely as a value array and a filter array.
+ * Keys outside the layout are kept as they were loaded and persisted again, but never recalled.
+ */
 class ParameterInfo : public Filterable, public Persistable {
 public:
-    explicit ParameterInfo(Filterable* parent);
+    //enough for the largest key table, TrackParam::COUNT
+    static constexpr size_t NAMED_CAPACITY = 40;
+
+    explicit ParameterInfo(Filterable* parent, const ParameterLayout* layout = nullptr);
     explicit ParameterInfo(Filterable* parent, ProjectStateContext* ctx);
+    ParameterInfo(const ParameterInfo& other);
+    ParameterInfo& operator=(const ParameterInfo& other);
 
-    std::map<std::string, Parameter<double>> mParams;
+    template<typename Key> requires std::is_enum_v<Key>
+    [[nodiscard]] double valueAt(Key key) const { return mNamedValues[(size_t) key]; }
+    template<typename Key> requires std::is_enum_v<Key>
+    [[nodiscard]] FilterMode filterAt(Key key) const { return (FilterMode) mNamedFilters[(size_t) key]; }
+    [[nodiscard]] size_t namedCount() const;
+    /** @return the interned key of a named parameter */
+    [[nodiscard]] const char* keyAt(size_t index) const;
+    [[nodiscard]] const double& namedValueAt(size_t index) const;
+    [[nodiscard]] FilterMode namedFilterAt(size_t index) const;
+    void setNamedValue(size_t index, double value);
+    void setNamedFilter(size_t index, FilterMode filter);
+    [[nodiscard]] bool isNamedFilteredInChain(size_t index) const;
+    void shuffleNamedFilter(size_t index);
+    [[nodiscard]] std::string getNamedTreeText(size_t index) const;
+    void insert(std::string_view key, double value, FilterMode filter);
 
-    [[nodiscard]] std::vector<std::string> getKeys();
-    [[nodiscard]] const Parameter<double>& at(const std::string &key) const;
-    [[nodiscard]] const Parameter<double>& at(int key) const;
-    void insert(const std::string &key, const Parameter<double> &value);
     void insert(int key, const Parameter<double> &value);
+    void insert(int key, double value, FilterMode filter = RECALLED);
+    [[nodiscard]] const double& valueAt(int key) const;
+    [[nodiscard]] FilterMode filterAt(int key) const;
+    void shuffleParamFilter(int key);
+    [[nodiscard]] std::string getParamTreeText(int key) const;
+    [[nodiscard]] bool isFilteredInChain(int key) const;
+    [[nodiscard]] int indexCount() const;
     [[nodiscard]] int size() const;
     void clear();
     [[nodiscard]] bool keyExists(int key) const;
@@ -54,10 +102,33 @@ public:
     FilterPreset* extractFilterPreset() override;
     bool applyFilterPreset(FilterPreset *preset) override;
 protected:
-    void persistHandler(WDL_FastString &str) const override;
-    bool initFromChunkHandler(std::string &key, std::vector<const char*> &params) override;
-    bool initFromChunkHandler(std::string &key, ProjectStateContext *ctx) override { return false; };
+    void persistHandler(ChunkWriter &str) const override;
+    bool initFromChunkHandler(std::string_view key, std::vector<const char*> &params) override;
+    bool initFromChunkHandler(std::string_view key, ProjectStateContext *ctx) override { return false; };
 private:
+    //marks indices below indexCount() that were never inserted
+    static constexpr uint8_t MISSING = UINT8_MAX;
+
+    struct UnknownParam {
+        std::string key;
+        double value;
+        FilterMode filter;
+    };
+
+    const ParameterLayout* mLayout;
+    std::array<double, NAMED_CAPACITY> mNamedValues{};
+    std::array<uint8_t, NAMED_CAPACITY> mNamedFilters{};
+    std::vector<UnknownParam> mUnknown;
+
+    std::vector<double> mValues;
+    std::vector<uint8_t> mFilters;
+    int mIndexedSize = 0;
+    //resolved filter chain of the indexed parameters, valid while mFilteredGeneration matches the filter generation
+    mutable std::vector<bool> mFiltered;
+    mutable unsigned int mFilteredGeneration = 0;
+
+    void resolveFilters() const;
+
     [[nodiscard]] std::string getChunkId() const override;
 };
 
@@ -27,39 +27,99 @@
 /
 ******************************************************************************/
 
+#include <cctype>
 #include <liblpe/data/models/base/Persistable.h>
-#include <lineparse.h>
 
 /**
  * Creates the element for persisting this class
  * @param str the string in which to save all persisting data
  */
 void Persistable::persist(WDL_FastString& str) const {
-    str.Append(("<" + getChunkId() + "\n").data());
+    auto writer = ChunkWriter(str);
+    persist(writer);
+}
+
+/**
+ * Writes the element for persisting this class line by line to ctx
+ */
+void Persistable::persist(ProjectStateContext* ctx) const {
+    auto writer = ChunkWriter(ctx);
+    persist(writer);
+}
+
+void Persistable::persist(ChunkWriter& str) const {
+    str.AppendFormatted(4096, "<%s\n", getChunkId().data());
 
     persistHandler(str);
 
     str.Append(">\n");
 }
 
+/**
+ * Splits a chunk line in place into its key and values, values may be quoted with ", ' or ` like for LineParser
+ * @return false if a quote is not closed
+ */
+static bool TokenizeLine(char* line, const char*& key, std::vector<const char*>& values) {
+    key = nullptr;
+    values.clear();
+    char* pos = line;
+    while (true) {
+        while (isspace((unsigned char) *pos)) {
+            pos++;
+        }
+        if (!*pos)
+            return true;
+
+        const char* token;
+        char quote = *pos;
+        if (quote == '"' || quote == '\'' || quote == '`') {
+            char* end = strchr(pos + 1, quote);
+            if (!end)
+                return false;
+            *end = '\0';
+            token = pos + 1;
+            pos = end + 1;
+        } else {
+            token = pos;
+            while (*pos && !isspace((unsigned char) *pos)) {
+                pos++;
+            }
+            if (*pos)
+                *pos++ = '\0';
+        }
+
+        if (key)
+            values.push_back(token);
+        else
+            key = token;
+    }
+}
+
+/**
+ * Reads the lines of this element until its closing line. The lines are tokenized in place and the values buffer is
+ * shared by all lines, so reading a line does not allocate
+ */
 void Persistable::initFromChunk(ProjectStateContext* ctx) {
     char buf[4096];
-    LineParser lp;
-    while (!ctx->GetLine(buf, sizeof(buf)) && !lp.parse(buf)) {
+    const char* key;
+    std::vector<const char*> vals;
+    while (!ctx->GetLine(buf, sizeof(buf))) {
+        //skip a malformed line instead of ending the element in the middle, the tokenized part is the key if any
+        if (!TokenizeLine(buf, key, vals)) {
+            fprintf(stderr, "Unclosed quote in line: %s\n", key ? key : buf);
+            continue;
+        }
+        if (!key)
+            continue;
+
         //found identifier
-        if (strncmp(lp.gettoken_str(0), "<", 1) == 0) {
-            std::string key = lp.gettoken_str(0) + 1;
-            if (!initFromChunkHandler(key, ctx))
-                fprintf(stderr, "Unhandled element: %s\n", key.data());
+        if (key[0] == '<') {
+            if (!initFromChunkHandler(key + 1, ctx))
+                fprintf(stderr, "Unhandled element: %s\n", key + 1);
 
-        } else if (strcmp(lp.gettoken_str(0), ">") == 0) {
+        } else if (strcmp(key, ">") == 0) {
             break;
         } else {
-            std::vector<const char*> vals;
-            for (int i = 1; i < lp.getnumtokens(); i++) {
-                vals.push_back(lp.gettoken_str(i));
-            }
-            std::string key = lp.gettoken_str(0);
             //default value
             if (vals.empty()) {
                 vals.push_back("0");
@@ -70,7 +130,30 @@ void Persistable::initFromChunk(ProjectStateContext* ctx) {
             }
 
             if (!initFromChunkHandler(key, vals))
-                fprintf(stderr, "Unhandled attribute: %s\n", key.data());
+                fprintf(stderr, "Unhandled attribute: %s\n", key);
+        }
+    }
+}
+
+/**
+ * Copies the lines of an element whose opening line was already read, up to and including its closing line
+ * @param ctx the context to read from
+ * @param str receives the lines without indentation, each terminated by '\n'
+ */
+void Persistable::copyElement(ProjectStateContext* ctx, WDL_FastString& str) {
+    char buf[4096];
+    int depth = 1;
+    while (depth > 0 && !ctx->GetLine(buf, sizeof(buf))) {
+        const char *line = buf;
+        while (*line == ' ' || *line == '\t')
+            line++;
+
+        if (line[0] == '<') {
+            depth++;
+        } else if (line[0] == '>' && line[1] == '\0') {
+            depth--;
         }
+        str.Append(line);
+        str.Append("\n");
     }
 }
\ No newline at end of file
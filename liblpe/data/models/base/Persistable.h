@@ -32,25 +32,27 @@
 
 
 #include <string>
+#include <string_view>
 #include <vector>
-#include <cstring> //needed for WDL/wdlstring
-#include <wdlstring.h>
-#include <reaper_plugin.h>
+#include <liblpe/data/models/base/ChunkWriter.h>
 
 class Persistable {
 public:
     //persistance
     virtual void persist(WDL_FastString& str) const final;
+    virtual void persist(ProjectStateContext* ctx) const final;
+    virtual void persist(ChunkWriter& str) const final;
     virtual void initFromChunk(ProjectStateContext* ctx) final;
 protected:
     //persistance
     /**
      * Persist all additional subclass data here
-     * @param str the string in which to save all persisting data
+     * @param str the writer to which all persisting data is written
      */
-    virtual void persistHandler(WDL_FastString& str) const = 0;
-    virtual bool initFromChunkHandler(std::string& key, std::vector<const char*>& params) = 0;
-    virtual bool initFromChunkHandler(std::string& key, ProjectStateContext* ctx) = 0;
+    virtual void persistHandler(ChunkWriter& str) const = 0;
+    virtual bool initFromChunkHandler(std::string_view key, std::vector<const char*>& params) = 0;
+    virtual bool initFromChunkHandler(std::string_view key, ProjectStateContext* ctx) = 0;
+    static void copyElement(ProjectStateContext* ctx, WDL_FastString& str);
 private:
     [[nodiscard]] virtual std::string getChunkId() const = 0;
 };
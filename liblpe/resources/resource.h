@@ -32,6 +32,12 @@
 #define IDC_LABEL1                      1370
 #define IDC_TAB                         1371
 #define IDC_ASSIGNINFO                  1372
+#define IDC_COMPILE_RECALL              1373
+#define IDC_SHADOW_STATE                1374
+#define IDC_SLICE_BUDGET                1375
+#define IDC_LABEL2                      1376
+#define IDC_LAZY_LOAD                   1377
+#define IDC_BINARY_CHUNK                1378
 
 //styles
 #define DEFAULT_FONT 8, "MS Shell Dlg"
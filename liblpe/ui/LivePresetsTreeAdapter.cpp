@@ -71,6 +71,19 @@ void LivePresetsTreeAdapter::onAction(HWND hwnd, HTREEITEM hItem) {
             break;
         }
         case TYPE::PARAM: {
+            if (data.index >= 0) {
+                auto& item = mData[qItem.lParam];
+                auto* params = (ParameterInfo*) item.lParam;
+                if (item.isNamed) {
+                    params->shuffleNamedFilter(item.index);
+                    item.text = params->getNamedTreeText(item.index);
+                } else {
+                    params->shuffleParamFilter(item.index);
+                    item.text = params->getParamTreeText(item.index);
+                }
+                qItem.pszText = item.text.data();
+                break;
+            }
             auto* param = (Parameter<double>*) data.lParam;
             param->shuffleFilter(true);
             qItem.pszText = param->getTreeText();
@@ -132,9 +145,7 @@ std::vector<TVITEM> LivePresetsTreeAdapter::getChilds(TVITEM* parent) {
                 break;
             }
             case TYPE::PARAMS: {
-                if (data.parentType != FX) {
-                    addChildsForParams((ParameterInfo*) data.lParam, &childs);
-                }
+                addChildsForParams((ParameterInfo*) data.lParam, &childs);
                 break;
             }
             case TYPE::FX: {
@@ -257,16 +268,35 @@ void LivePresetsTreeAdapter::addChildsForMasterTrack(MasterTrackInfo* item, std:
 }
 
 void LivePresetsTreeAdapter::addChildsForParams(ParameterInfo* item, std::vector<TVITEM>* childs) {
-    for (auto& key : item->getKeys()) {
-        const auto& param = item->at(key);
+    //parameters have no object of their own, the item keeps their container, index and text
+    for (size_t i = 0; i < item->namedCount(); i++) {
+        auto lparam = (LPARAM) &item->namedValueAt(i);
+        auto& data = mData[lparam];
+        data = {TYPE::PARAM, (LPARAM) item, TYPE::PARAMS, (int) i, true, item->getNamedTreeText(i)};
+
         TVITEM child;
         child.mask = TVIF_TEXT | TVIF_PARAM;
 
-        child.pszText = param.getTreeText();
-        child.cchTextMax = sizeof(param.getTreeText());
+        child.pszText = data.text.data();
+        child.cchTextMax = (int) data.text.size() + 1;
+        child.lParam = lparam;
+
+        childs->push_back(child);
+    }
+
+    for (int i = 0; i < item->indexCount(); i++) {
+        if (!item->keyExists(i))
+            continue;
+
+        auto lparam = (LPARAM) &item->valueAt(i);
+        auto& data = mData[lparam];
+        data = {TYPE::PARAM, (LPARAM) item, TYPE::PARAMS, i, false, item->getParamTreeText(i)};
+
+        TVITEM child;
+        child.mask = TVIF_TEXT | TVIF_PARAM;
 
-        auto lparam = (LPARAM) &param;
-        mData[lparam] = {TYPE::PARAM, lparam, TYPE::PARAMS};
+        child.pszText = data.text.data();
+        child.cchTextMax = (int) data.text.size() + 1;
         child.lParam = lparam;
 
         childs->push_back(child);
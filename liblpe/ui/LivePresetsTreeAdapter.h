@@ -56,6 +56,11 @@ private:
         TYPE type;
         LPARAM lParam;
         TYPE parentType;
+        //index of a parameter of the ParameterInfo in lParam, -1 for all other items
+        int index = -1;
+        //true for a named parameter, false for an indexed one
+        bool isNamed = false;
+        std::string text;
     } ItemData;
 
     //used to keep a reference of ItemData that it doesn't leak
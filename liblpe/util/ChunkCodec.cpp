@@ -0,0 +1,396 @@
+/******************************************************************************
+/ LivePresetsExtension
+/
+/ Compact binary encoding of persisted chunk lines
+/
+/ Copyright (c) 2020 and later Dr. med. Frederik Bertling
+/
+/
+/ Permission is hereby granted, free of charge, to any person obtaining a copy
+/ of this software and associated documentation files (the "Software"), to deal
+/ in the Software without restriction, including without limitation the rights to
+/ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+/ of the Software, and to permit persons to whom the Software is furnished to
+/ do so, subject to the following conditions:
+/
+/ The above copyright notice and this permission notice shall be included in all
+/ copies or substantial portions of the Software.
+/
+/ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+/ EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+/ OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+/ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+/ HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+/ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/ FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+/ OTHER DEALINGS IN THE SOFTWARE.
+/
+******************************************************************************/
+
+#include <liblpe/util/ChunkCodec.h>
+#include <liblpe/util/util.h>
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+static constexpr char MAGIC[] = "LPEB";
+static constexpr size_t MAGIC_LENGTH = sizeof(MAGIC) - 1;
+static constexpr size_t GUID_LENGTH = 38;
+static constexpr char HEX[] = "0123456789ABCDEF";
+//type of an encoded word, NEW_ types define the next entry of their table
+enum Tag : uint8_t {
+    STRING = 0,
+    NEW_STRING = 1,
+    INT = 2,
+    DOUBLE_FIXED = 3,
+    DOUBLE_SHORTEST = 4,
+    GUID_STRING = 5,
+    NEW_GUID_STRING = 6
+};
+
+static constexpr char BASE64[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+static void WriteVarint(std::string& data, uint64_t value) {
+    while (value >= 0x80) {
+        data.push_back((char) (value | 0x80));
+        value >>= 7;
+    }
+    data.push_back((char) value);
+}
+
+static bool ReadVarint(std::string_view data, size_t& pos, uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64 && pos < data.size(); shift += 7) {
+        auto byte = (uint8_t) data[pos++];
+        value |= (uint64_t) (byte & 0x7F) << shift;
+        if (!(byte & 0x80))
+            return true;
+    }
+    return false;
+}
+
+/**
+ * Only words that are written back to the same text are stored as numbers, "007" or "1.50" stay strings
+ */
+static bool ParseWordInt(std::string_view word, int64_t& value) {
+    if (word.empty() || word.size() > 20 || (word[0] != '-' && (word[0] < '0' || word[0] > '9')))
+        return false;
+    auto [ptr, ec] = std::from_chars(word.data(), word.data() + word.size(), value);
+    if (ec != std::errc() || ptr != word.data() + word.size())
+        return false;
+
+    char buf[24];
+    auto res = std::to_chars(buf, buf + sizeof(buf), value);
+    return std::string_view(buf, res.ptr - buf) == word;
+}
+
+static bool IsDoubleText(std::string_view word, double value, bool isShortest) {
+    char buf[128];
+    if (isShortest)
+        FormatDouble(value, buf, sizeof(buf));
+    else if (!FormatDoubleFixed(value, 17, buf, sizeof(buf)))
+        return false;
+    return word == buf;
+}
+
+/**
+ * @return the tag of the format that writes value back to word, 0 when word is no double
+ */
+static uint8_t ParseWordDouble(std::string_view word, double& value) {
+    if (word.empty() || word.size() > 64 || (word[0] != '-' && (word[0] < '0' || word[0] > '9')))
+        return 0;
+    //trailing garbage is rejected by writing the value back below
+    char text[65];
+    memcpy(text, word.data(), word.size());
+    text[word.size()] = '\0';
+    value = ParseDouble(text);
+
+    //"%.17f" has 17 decimals, try the fixed format first then
+    auto dot = word.find('.');
+    if (dot != std::string_view::npos && word.size() - dot - 1 == 17 && IsDoubleText(word, value, false))
+        return DOUBLE_FIXED;
+    if (IsDoubleText(word, value, true))
+        return DOUBLE_SHORTEST;
+    return 0;
+}
+
+static int HexValue(char c) {
+    if (c >= '0' && c <= '9')
+        return c - '0';
+    if (c >= 'A' && c <= 'F')
+        return c - 'A' + 10;
+    return -1;
+}
+
+static bool IsGuidDash(size_t i) {
+    return i == 9 || i == 14 || i == 19 || i == 24;
+}
+
+/**
+ * Packs a guid in the upper case form of guidToString into 16 bytes
+ */
+static bool PackGuid(std::string_view word, uint8_t* bytes) {
+    if (word.size() != GUID_LENGTH || word.front() != '{' || word.back() != '}')
+        return false;
+
+    int nibble = 0;
+    for (size_t i = 1; i < GUID_LENGTH - 1; i++) {
+        if (IsGuidDash(i)) {
+            if (word[i] != '-')
+                return false;
+            continue;
+        }
+        int value = HexValue(word[i]);
+        if (value < 0)
+            return false;
+        if (nibble % 2 == 0) {
+            bytes[nibble / 2] = (uint8_t) (value << 4);
+        } else {
+            bytes[nibble / 2] |= (uint8_t) value;
+        }
+        nibble++;
+    }
+    return true;
+}
+
+static std::string UnpackGuid(const uint8_t* bytes) {
+    std::string guid(GUID_LENGTH, '-');
+    guid.front() = '{';
+    guid.back() = '}';
+
+    int nibble = 0;
+    for (size_t i = 1; i < GUID_LENGTH - 1; i++) {
+        if (IsGuidDash(i))
+            continue;
+        uint8_t byte = bytes[nibble / 2];
+        guid[i] = HEX[nibble % 2 == 0 ? byte >> 4 : byte & 0x0F];
+        nibble++;
+    }
+    return guid;
+}
+
+/**
+ * Encodes the lines of text, a missing '\n' after the last line is added by decode
+ * @param text persisted chunk lines
+ * @param data receives the binary data
+ */
+void ChunkCodec::encode(std::string_view text, std::string& data) {
+    data.clear();
+    data.append(MAGIC, MAGIC_LENGTH);
+    data.push_back((char) VERSION);
+
+    std::unordered_map<std::string_view, uint64_t> strings;
+    std::unordered_map<std::string_view, uint64_t> guids;
+
+    size_t pos = 0;
+    while (pos < text.size()) {
+        auto end = std::min(text.find('\n', pos), text.size());
+        auto line = text.substr(pos, end - pos);
+        pos = end + 1;
+
+        WriteVarint(data, std::count(line.begin(), line.end(), ' ') + 1);
+        size_t start = 0;
+        while (true) {
+            auto space = line.find(' ', start);
+            auto word = line.substr(start, space == std::string_view::npos ? std::string_view::npos : space - start);
+
+            int64_t intValue;
+            double doubleValue;
+            uint8_t guid[16];
+            if (ParseWordInt(word, intValue)) {
+                data.push_back(INT);
+                //zigzag keeps small negative values short
+                WriteVarint(data, ((uint64_t) intValue << 1) ^ (uint64_t) (intValue >> 63));
+            } else if (PackGuid(word, guid)) {
+                auto [it, isNew] = guids.try_emplace(word, guids.size());
+                if (isNew) {
+                    data.push_back(NEW_GUID_STRING);
+                    data.append((const char*) guid, sizeof(guid));
+                } else {
+                    data.push_back(GUID_STRING);
+                    WriteVarint(data, it->second);
+                }
+            } else if (auto tag = ParseWordDouble(word, doubleValue)) {
+                data.push_back(tag);
+                uint64_t bits;
+                memcpy(&bits, &doubleValue, sizeof(bits));
+                for (int i = 0; i < 8; i++) {
+                    data.push_back((char) (bits >> (i * 8)));
+                }
+            } else {
+                auto [it, isNew] = strings.try_emplace(word, strings.size());
+                if (isNew) {
+                    data.push_back(NEW_STRING);
+                    WriteVarint(data, word.size());
+                    data.append(word);
+                } else {
+                    data.push_back(STRING);
+                    WriteVarint(data, it->second);
+                }
+            }
+
+            if (space == std::string_view::npos)
+                break;
+            start = space + 1;
+        }
+    }
+}
+
+/**
+ * @param data binary data created by encode
+ * @param text receives the chunk lines, each terminated by '\n'
+ * @return false when data is not a supported encoding or truncated
+ */
+bool ChunkCodec::decode(std::string_view data, std::string& text) {
+    text.clear();
+    if (data.size() <= MAGIC_LENGTH || data.substr(0, MAGIC_LENGTH) != MAGIC || data[MAGIC_LENGTH] != VERSION)
+        return false;
+
+    std::vector<std::string_view> strings;
+    std::vector<std::string> guids;
+    char buf[128];
+
+    size_t pos = MAGIC_LENGTH + 1;
+    while (pos < data.size()) {
+        uint64_t count;
+        if (!ReadVarint(data, pos, count))
+            return false;
+
+        for (uint64_t i = 0; i < count; i++) {
+            if (i > 0)
+                text.push_back(' ');
+            if (pos >= data.size())
+                return false;
+
+            uint64_t value;
+            auto tag = (uint8_t) data[pos++];
+            switch (tag) {
+                case STRING:
+                    if (!ReadVarint(data, pos, value) || value >= strings.size())
+                        return false;
+                    text.append(strings[value]);
+                    break;
+                case NEW_STRING:
+                    if (!ReadVarint(data, pos, value) || value > data.size() - pos)
+                        return false;
+                    strings.push_back(data.substr(pos, value));
+                    text.append(strings.back());
+                    pos += value;
+                    break;
+                case INT: {
+                    if (!ReadVarint(data, pos, value))
+                        return false;
+                    auto intValue = (int64_t) (value >> 1) ^ -(int64_t) (value & 1);
+                    auto res = std::to_chars(buf, buf + sizeof(buf), intValue);
+                    text.append(buf, res.ptr - buf);
+                    break;
+                }
+                case DOUBLE_FIXED:
+                case DOUBLE_SHORTEST: {
+                    if (data.size() - pos < 8)
+                        return false;
+                    uint64_t bits = 0;
+                    for (int b = 0; b < 8; b++) {
+                        bits |= (uint64_t) (uint8_t) data[pos + b] << (b * 8);
+                    }
+                    pos += 8;
+                    double doubleValue;
+                    memcpy(&doubleValue, &bits, sizeof(doubleValue));
+                    if (tag == DOUBLE_SHORTEST)
+                        FormatDouble(doubleValue, buf, sizeof(buf));
+                    else if (!FormatDoubleFixed(doubleValue, 17, buf, sizeof(buf)))
+                        return false;
+                    text.append(buf);
+                    break;
+                }
+                case GUID_STRING:
+                    if (!ReadVarint(data, pos, value) || value >= guids.size())
+                        return false;
+                    text.append(guids[value]);
+                    break;
+                case NEW_GUID_STRING:
+                    if (data.size() - pos < 16)
+                        return false;
+                    guids.push_back(UnpackGuid((const uint8_t*) data.data() + pos));
+                    text.append(guids.back());
+                    pos += 16;
+                    break;
+                default:
+                    return false;
+            }
+        }
+        text.push_back('\n');
+    }
+    return true;
+}
+
+void ChunkCodec::encodeBase64(std::string_view data, std::string& base64) {
+    base64.clear();
+    base64.reserve((data.size() + 2) / 3 * 4);
+
+    for (size_t i = 0; i < data.size(); i += 3) {
+        uint32_t block = (uint32_t) (uint8_t) data[i] << 16;
+        if (i + 1 < data.size())
+            block |= (uint32_t) (uint8_t) data[i + 1] << 8;
+        if (i + 2 < data.size())
+            block |= (uint8_t) data[i + 2];
+
+        base64.push_back(BASE64[(block >> 18) & 0x3F]);
+        base64.push_back(BASE64[(block >> 12) & 0x3F]);
+        base64.push_back(i + 1 < data.size() ? BASE64[(block >> 6) & 0x3F] : '=');
+        base64.push_back(i + 2 < data.size() ? BASE64[block & 0x3F] : '=');
+    }
+}
+
+bool ChunkCodec::decodeBase64(std::string_view base64, std::string& data) {
+    data.clear();
+    if (base64.size() % 4 != 0)
+        return false;
+    data.reserve(base64.size() / 4 * 3);
+
+    int8_t values[256];
+    memset(values, -1, sizeof(values));
+    for (int i = 0; i < 64; i++) {
+        values[(uint8_t) BASE64[i]] = (int8_t) i;
+    }
+
+    for (size_t i = 0; i < base64.size(); i += 4) {
+        uint32_t block = 0;
+        int padding = 0;
+        for (size_t j = 0; j < 4; j++) {
+            char c = base64[i + j];
+            //padding is only allowed at the end
+            if (c == '=' && i + 4 == base64.size() && j >= 2) {
+                padding++;
+                block <<= 6;
+                continue;
+            }
+            if (padding > 0 || values[(uint8_t) c] < 0)
+                return false;
+            block = (block << 6) | (uint32_t) values[(uint8_t) c];
+        }
+
+        data.push_back((char) (block >> 16));
+        if (padding < 2)
+            data.push_back((char) (block >> 8));
+        if (padding < 1)
+            data.push_back((char) block);
+    }
+    return true;
+}
+
+/**
+ * Appends base64 as the lines a binary chunk is saved as, an ENCODING line followed by DATA lines of LINE_LENGTH chars
+ */
+void ChunkCodec::appendLines(int version, std::string_view base64, std::string& lines) {
+    lines += "ENCODING ";
+    lines += std::to_string(version);
+    lines += '\n';
+    for (size_t pos = 0; pos < base64.size(); pos += LINE_LENGTH) {
+        lines += "DATA ";
+        lines += base64.substr(pos, LINE_LENGTH);
+        lines += '\n';
+    }
+}
\ No newline at end of file
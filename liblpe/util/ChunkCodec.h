@@ -0,0 +1,56 @@
+/******************************************************************************
+/ LivePresetsExtension
+/
+/ Compact binary encoding of persisted chunk lines
+/
+/ Copyright (c) 2020 and later Dr. med. Frederik Bertling
+/
+/
+/ Permission is hereby granted, free of charge, to any person obtaining a copy
+/ of this software and associated documentation files (the "Software"), to deal
+/ in the Software without restriction, including without limitation the rights to
+/ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+/ of the Software, and to permit persons to whom the Software is furnished to
+/ do so, subject to the following conditions:
+/
+/ The above copyright notice and this permission notice shall be included in all
+/ copies or substantial portions of the Software.
+/
+/ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+/ EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+/ OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+/ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+/ HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+/ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/ FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+/ OTHER DEALINGS IN THE SOFTWARE.
+/
+******************************************************************************/
+
+#ifndef LPE_CHUNKCODEC_H
+#define LPE_CHUNKCODEC_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/**
+ * Lossless binary encoding of chunk lines. Words are split at single spaces and stored as varint integers, raw
+ * doubles, indices into a GUID table or indices into a string table, so repeated keys and guids cost a few bytes.
+ * Decoding reproduces the text byte by byte, so the existing chunk parsers read it unchanged
+ */
+class ChunkCodec {
+public:
+    static constexpr int VERSION = 1;
+    //base64 chars per chunk line
+    static constexpr size_t LINE_LENGTH = 128;
+
+    static void encode(std::string_view text, std::string& data);
+    [[nodiscard]] static bool decode(std::string_view data, std::string& text);
+    static void encodeBase64(std::string_view data, std::string& base64);
+    [[nodiscard]] static bool decodeBase64(std::string_view base64, std::string& data);
+    static void appendLines(int version, std::string_view base64, std::string& lines);
+};
+
+
+#endif //LPE_CHUNKCODEC_H
\ No newline at end of file
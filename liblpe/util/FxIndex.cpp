@@ -0,0 +1,75 @@
+/******************************************************************************
+/ LivePresetsExtension
+/
+/ Caches the chain position of track FX by their GUID
+/
+/ Copyright (c) 2020 and later Dr. med. Frederik Bertling
+/
+/
+/ Permission is hereby granted, free of charge, to any person obtaining a copy
+/ of this software and associated documentation files (the "Software"), to deal
+/ in the Software without restriction, including without limitation the rights to
+/ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+/ of the Software, and to permit persons to whom the Software is furnished to
+/ do so, subject to the following conditions:
+/
+/ The above copyright notice and this permission notice shall be included in all
+/ copies or substantial portions of the Software.
+/
+/ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+/ EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+/ OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+/ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+/ HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+/ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/ FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+/ OTHER DEALINGS IN THE SOFTWARE.
+/
+******************************************************************************/
+
+#include <liblpe/util/FxIndex.h>
+#include <liblpe/data/models/FxInfo.h>
+
+/**
+ * Returns the current index of the fx with the given guid on the track
+ * @param track the track that holds the fx
+ * @param guid the fx guid
+ * @return the fx index, RecFx are offset by FxInfo::RECFX_INDEX_FACTOR. -1 when the fx was not found.
+ */
+int FxIndex::find(MediaTrack* track, const GUID& guid) {
+    if (!track)
+        return -1;
+
+    auto it = mLocations.find(guid);
+    if (it != mLocations.end() && it->second.track == track) {
+        const GUID* current = TrackFX_GetFXGUID(track, it->second.index);
+        if (current && GuidsEqual(*current, guid))
+            return it->second.index;
+    }
+
+    //fx was moved, added or is not known yet
+    scan(track);
+
+    it = mLocations.find(guid);
+    if (it != mLocations.end() && it->second.track == track)
+        return it->second.index;
+    return -1;
+}
+
+/**
+ * Drops all cached locations, called when reaper notifies about changed fx chains
+ */
+void FxIndex::invalidate() {
+    mLocations.clear();
+}
+
+void FxIndex::scan(MediaTrack* track) {
+    for (int i = 0; i < TrackFX_GetCount(track); i++) {
+        if (const GUID* guid = TrackFX_GetFXGUID(track, i))
+            mLocations[*guid] = Location{track, i};
+    }
+    for (int i = FxInfo::RECFX_INDEX_FACTOR; i < FxInfo::RECFX_INDEX_FACTOR + TrackFX_GetRecCount(track); i++) {
+        if (const GUID* guid = TrackFX_GetFXGUID(track, i))
+            mLocations[*guid] = Location{track, i};
+    }
+}
\ No newline at end of file
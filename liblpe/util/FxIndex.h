@@ -0,0 +1,56 @@
+/******************************************************************************
+/ LivePresetsExtension
+/
+/ Caches the chain position of track FX by their GUID
+/
+/ Copyright (c) 2020 and later Dr. med. Frederik Bertling
+/
+/
+/ Permission is hereby granted, free of charge, to any person obtaining a copy
+/ of this software and associated documentation files (the "Software"), to deal
+/ in the Software without restriction, including without limitation the rights to
+/ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+/ of the Software, and to permit persons to whom the Software is furnished to
+/ do so, subject to the following conditions:
+/
+/ The above copyright notice and this permission notice shall be included in all
+/ copies or substantial portions of the Software.
+/
+/ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+/ EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+/ OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+/ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+/ HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+/ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/ FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+/ OTHER DEALINGS IN THE SOFTWARE.
+/
+******************************************************************************/
+
+#ifndef LPE_FXINDEX_H
+#define LPE_FXINDEX_H
+
+#include <unordered_map>
+#include <liblpe/util/util.h>
+
+/**
+ * Cache from FX GUID to its track and index in the FX or record FX chain. Shared by all presets of a model.
+ * Cached locations are verified with a single TrackFX_GetFXGUID call, only a miss rescans the chain of one track
+ */
+class FxIndex {
+public:
+    [[nodiscard]] int find(MediaTrack* track, const GUID& guid);
+    void invalidate();
+private:
+    typedef struct {
+        MediaTrack* track;
+        int index;
+    } Location;
+
+    std::unordered_map<GUID, Location, GuidHash, GuidEqual> mLocations;
+
+    void scan(MediaTrack* track);
+};
+
+
+#endif //LPE_FXINDEX_H
\ No newline at end of file
@@ -0,0 +1,105 @@
+/******************************************************************************
+/ LivePresetsExtension
+/
+/ Tracks which muted tracks are shown in the TCP
+/
+/ Copyright (c) 2020 and later Dr. med. Frederik Bertling
+/
+/
+/ Permission is hereby granted, free of charge, to any person obtaining a copy
+/ of this software and associated documentation files (the "Software"), to deal
+/ in the Software without restriction, including without limitation the rights to
+/ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+/ of the Software, and to permit persons to whom the Software is furnished to
+/ do so, subject to the following conditions:
+/
+/ The above copyright notice and this permission notice shall be included in all
+/ copies or substantial portions of the Software.
+/
+/ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+/ EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+/ OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+/ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+/ HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+/ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/ FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+/ OTHER DEALINGS IN THE SOFTWARE.
+/
+******************************************************************************/
+
+#include <liblpe/util/MutedTracksCache.h>
+#include <liblpe/data/models/base/BaseTrackInfo.h>
+
+/**
+ * Returns if there is a muted track shown in TCP
+ */
+bool MutedTracksCache::isMutedShown() {
+    int stateChangeCount = GetProjectStateChangeCount(nullptr);
+    if (!mIsValid || !isStateKnown(stateChangeCount)) {
+        rebuild();
+        mStateChangeCount = stateChangeCount;
+    }
+    return mShownCount > 0;
+}
+
+/**
+ * Called by ProjectChangeListener when the mute state of a single track changed. The project state change caused by
+ * the mute is accounted for, so the next query does not scan all tracks again
+ */
+void MutedTracksCache::onMuteChanged(MediaTrack* track, bool mute) {
+    if (!mIsValid)
+        return;
+    //other changes since the last scan were not applied, scan them on the next query
+    if (!isStateKnown(GetProjectStateChangeCount(nullptr))) {
+        mIsValid = false;
+        return;
+    }
+    mIsMuteUndoPending = true;
+
+    auto it = mMutedTracks.find(track);
+    if (it != mMutedTracks.end()) {
+        mShownCount -= it->second;
+        mMutedTracks.erase(it);
+    }
+    //the master track is not part of the track list
+    if (!mute || GetMediaTrackInfo_Value(track, "IP_TRACKNUMBER") <= 0)
+        return;
+
+    bool isShown = GetMediaTrackInfo_Value(track, B_SHOWINTCP) != 0;
+    mMutedTracks.emplace(track, isShown);
+    mShownCount += isShown;
+}
+
+/**
+ * Marks the cache as outdated, called when tracks or their visibility may have changed
+ */
+void MutedTracksCache::invalidate() {
+    mIsValid = false;
+}
+
+/**
+ * Checks if the project state is the one of the last scan or applied mute change. The undo point of a mute change
+ * is added after the change was reported, so one more state change is accepted after a mute change
+ */
+bool MutedTracksCache::isStateKnown(int stateChangeCount) {
+    if (mIsMuteUndoPending && stateChangeCount == mStateChangeCount + 1)
+        mStateChangeCount = stateChangeCount;
+    mIsMuteUndoPending = false;
+    return mStateChangeCount == stateChangeCount;
+}
+
+void MutedTracksCache::rebuild() {
+    mMutedTracks.clear();
+    mShownCount = 0;
+    mIsMuteUndoPending = false;
+    for (int i = 0; i < GetNumTracks(); i++) {
+        MediaTrack* track = GetTrack(nullptr, i);
+
+        if (GetMediaTrackInfo_Value(track, B_MUTE) != 0) {
+            bool isShown = GetMediaTrackInfo_Value(track, B_SHOWINTCP) != 0;
+            mMutedTracks.emplace(track, isShown);
+            mShownCount += isShown;
+        }
+    }
+    mIsValid = true;
+}
\ No newline at end of file
@@ -0,0 +1,61 @@
+/******************************************************************************
+/ LivePresetsExtension
+/
+/ Tracks which muted tracks are shown in the TCP
+/
+/ Copyright (c) 2020 and later Dr. med. Frederik Bertling
+/
+/
+/ Permission is hereby granted, free of charge, to any person obtaining a copy
+/ of this software and associated documentation files (the "Software"), to deal
+/ in the Software without restriction, including without limitation the rights to
+/ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+/ of the Software, and to permit persons to whom the Software is furnished to
+/ do so, subject to the following conditions:
+/
+/ The above copyright notice and this permission notice shall be included in all
+/ copies or substantial portions of the Software.
+/
+/ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+/ EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+/ OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+/ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+/ HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+/ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/ FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+/ OTHER DEALINGS IN THE SOFTWARE.
+/
+******************************************************************************/
+
+#ifndef LPE_MUTEDTRACKSCACHE_H
+#define LPE_MUTEDTRACKSCACHE_H
+
+#include <unordered_map>
+#include <liblpe/util/util.h>
+
+/**
+ * Answers whether a muted track is shown in the TCP without visiting all tracks. Mute changes are applied one track at
+ * a time by ProjectChangeListener, visibility changes invalidate the cache and the tracks are scanned again on the next
+ * query. Visibility changed by REAPER itself, e.g. in the TCP or the track manager, is noticed by the project state
+ * change count. The state change of an applied mute change does not cause a scan.
+ */
+class MutedTracksCache {
+public:
+    [[nodiscard]] bool isMutedShown();
+    void onMuteChanged(MediaTrack* track, bool mute);
+    void invalidate();
+private:
+    //muted tracks and whether they are shown in the TCP
+    std::unordered_map<MediaTrack*, bool> mMutedTracks;
+    int mShownCount = 0;
+    int mStateChangeCount = -1;
+    //a mute change was applied and its undo point may not have been counted yet
+    bool mIsMuteUndoPending = false;
+    bool mIsValid = false;
+
+    bool isStateKnown(int stateChangeCount);
+    void rebuild();
+};
+
+
+#endif //LPE_MUTEDTRACKSCACHE_H
\ No newline at end of file
@@ -42,10 +42,124 @@ const char *ProjectChangeListener::GetConfigString() {
     return "";
 }
 
+void ProjectChangeListener::Run() {
+    if (g_lpe->mModel)
+        g_lpe->mModel->onRun();
+}
+
 void ProjectChangeListener::SetTrackListChange() {
     auto val = (long long) GetMediaTrackInfo_Value(GetMasterTrack(nullptr), "P_PROJECT");
     auto *proj = (ReaProject*) val;
     if (g_lpe->mProject != proj) {
         g_lpe->onProjectChanged(proj);
     }
+
+    //tracks were added, removed or reordered, resolve them again on next access
+    if (g_lpe->mModel) {
+        g_lpe->mModel->mTrackIndex.invalidate();
+        g_lpe->mModel->mFxIndex.invalidate();
+        g_lpe->mModel->mShadowState.invalidate();
+        g_lpe->mModel->mMutedTracks.invalidate();
+    }
+    onStateChanged();
+}
+
+void ProjectChangeListener::SetSurfaceVolume(MediaTrack* track, double) {
+    onStateChanged();
+    onTrackValueChanged(track, D_VOL);
+}
+
+void ProjectChangeListener::SetSurfacePan(MediaTrack* track, double) {
+    onStateChanged();
+    onTrackValueChanged(track, D_PAN);
+    onTrackValueChanged(track, D_WIDTH);
+    onTrackValueChanged(track, D_DUALPANL);
+    onTrackValueChanged(track, D_DUALPANR);
+}
+
+void ProjectChangeListener::SetSurfaceMute(MediaTrack* track, bool mute) {
+    onStateChanged();
+    onTrackValueChanged(track, B_MUTE);
+    if (g_lpe->mModel)
+        g_lpe->mModel->mMutedTracks.onMuteChanged(track, mute);
+}
+
+void ProjectChangeListener::SetSurfaceSelected(MediaTrack* track, bool) {
+    onStateChanged();
+    onTrackValueChanged(track, I_SELECTED);
+}
+
+void ProjectChangeListener::SetSurfaceSolo(MediaTrack* track, bool) {
+    onStateChanged();
+    onTrackValueChanged(track, I_SOLO);
+}
+
+void ProjectChangeListener::SetSurfaceRecArm(MediaTrack* track, bool) {
+    onStateChanged();
+    onTrackValueChanged(track, I_RECARM);
+}
+
+int ProjectChangeListener::Extended(int call, void* parm1, void* parm2, void*) {
+    //fx were added, removed or reordered
+    if (call == CSURF_EXT_SETFXCHANGE && g_lpe->mModel) {
+        g_lpe->mModel->mFxIndex.invalidate();
+    }
+
+    switch (call) {
+        case CSURF_EXT_SETFXCHANGE:
+        case CSURF_EXT_SETFXPARAM:
+        case CSURF_EXT_SETFXPARAM_RECFX:
+        case CSURF_EXT_SETFXENABLED:
+        case CSURF_EXT_SETSENDVOLUME:
+        case CSURF_EXT_SETSENDPAN:
+        case CSURF_EXT_TRACKFX_PRESET_CHANGED:
+            onStateChanged();
+            break;
+        default:
+            break;
+    }
+
+    //remove changed values from the shadow state, the recall itself keeps it up to date
+    if (!g_lpe->mModel || g_lpe->mModel->mShadowState.isRecalling())
+        return 0;
+
+    auto& shadowState = g_lpe->mModel->mShadowState;
+    auto* track = (MediaTrack*) parm1;
+    switch (call) {
+        case CSURF_EXT_SETFXPARAM:
+        case CSURF_EXT_SETFXPARAM_RECFX: {
+            //parm2 is fxidx << 16 | paramidx
+            int fx = (*(int*) parm2 >> 16) & 0xFFFF;
+            int param = *(int*) parm2 & 0xFFFF;
+            if (call == CSURF_EXT_SETFXPARAM_RECFX)
+                fx += FxInfo::RECFX_INDEX_FACTOR;
+            shadowState.invalidateFxParam(track, fx, param);
+            break;
+        }
+        case CSURF_EXT_SETFXCHANGE:
+        case CSURF_EXT_SETFXENABLED:
+        case CSURF_EXT_TRACKFX_PRESET_CHANGED:
+            shadowState.invalidateFxs(track);
+            break;
+        case CSURF_EXT_SETSENDVOLUME:
+        case CSURF_EXT_SETSENDPAN:
+            shadowState.invalidateSends(track);
+            break;
+        default:
+            break;
+    }
+    return 0;
+}
+
+/**
+ * The project no longer matches the active preset, the next recall can't use a cached transition
+ */
+void ProjectChangeListener::onStateChanged() {
+    if (g_lpe->mModel)
+        g_lpe->mModel->onStateChanged();
+}
+
+void ProjectChangeListener::onTrackValueChanged(MediaTrack* track, const char* key) {
+    if (g_lpe->mModel && !g_lpe->mModel->mShadowState.isRecalling())
+        g_lpe->mModel->mShadowState.invalidateTrackValue(track, key);
 }
\ No newline at end of file
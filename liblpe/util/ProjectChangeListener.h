@@ -38,7 +38,18 @@ public:
     const char *GetDescString() override;
     const char *GetConfigString() override;
 
+    void Run() override;
     void SetTrackListChange() override;
+    void SetSurfaceVolume(MediaTrack* track, double volume) override;
+    void SetSurfacePan(MediaTrack* track, double pan) override;
+    void SetSurfaceMute(MediaTrack* track, bool mute) override;
+    void SetSurfaceSelected(MediaTrack* track, bool selected) override;
+    void SetSurfaceSolo(MediaTrack* track, bool solo) override;
+    void SetSurfaceRecArm(MediaTrack* track, bool recarm) override;
+    int Extended(int call, void* parm1, void* parm2, void* parm3) override;
+private:
+    static void onStateChanged();
+    static void onTrackValueChanged(MediaTrack* track, const char* key);
 };
 
 #endif //LPE_PROJECTCHANGELISTENER_H
@@ -0,0 +1,117 @@
+/******************************************************************************
+/ LivePresetsExtension
+/
+/ Maps recall ids to the presets that are recalled by MIDI or OSC values
+/
+/ Copyright (c) 2020 and later Dr. med. Frederik Bertling
+/
+/
+/ Permission is hereby granted, free of charge, to any person obtaining a copy
+/ of this software and associated documentation files (the "Software"), to deal
+/ in the Software without restriction, including without limitation the rights to
+/ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+/ of the Software, and to permit persons to whom the Software is furnished to
+/ do so, subject to the following conditions:
+/
+/ The above copyright notice and this permission notice shall be included in all
+/ copies or substantial portions of the Software.
+/
+/ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+/ EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+/ OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+/ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+/ HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+/ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/ FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+/ OTHER DEALINGS IN THE SOFTWARE.
+/
+******************************************************************************/
+
+#include <algorithm>
+#include <bit>
+#include <liblpe/util/RecallIdTable.h>
+#include <liblpe/data/models/LivePreset.h>
+
+RecallIdTable::RecallIdTable() : mPresets(SIZE, nullptr) {}
+
+/**
+ * @return the preset with the given recall id or nullptr
+ */
+LivePreset* RecallIdTable::find(int id) const {
+    if (id < 0 || id >= SIZE)
+        return nullptr;
+    return mPresets[id];
+}
+
+/**
+ * Returns the first unused id starting at id, wrapping around at the end of the table. An id held by a preset with the
+ * same guid is free as it belongs to the preset itself, e.g. to an edited copy
+ * @param preset the preset to assign the id to
+ * @param id the requested id
+ * @return the id or -1 when all ids are used
+ */
+int RecallIdTable::getFreeId(const LivePreset* preset, int id) const {
+    id = std::clamp(id, 0, SIZE - 1);
+
+    int ownId = -1;
+    auto* holder = find(preset->mRecallId);
+    if (holder && GuidsEqual(holder->mGuid, preset->mGuid))
+        ownId = preset->mRecallId;
+
+    int freeId = findFree(id, SIZE, ownId);
+    if (freeId == -1)
+        freeId = findFree(0, id, ownId);
+    return freeId;
+}
+
+/**
+ * Adds a preset, its id is not taken when another preset already holds it
+ */
+void RecallIdTable::insert(LivePreset* preset) {
+    int id = preset->mRecallId;
+    if (id < 0 || id >= SIZE || mPresets[id])
+        return;
+
+    mPresets[id] = preset;
+    mUsed[id / WORD_BITS] |= 1ull << (id % WORD_BITS);
+}
+
+void RecallIdTable::remove(const LivePreset* preset) {
+    int id = preset->mRecallId;
+    if (id < 0 || id >= SIZE || mPresets[id] != preset)
+        return;
+
+    mPresets[id] = nullptr;
+    mUsed[id / WORD_BITS] &= ~(1ull << (id % WORD_BITS));
+}
+
+/**
+ * Fills the table from scratch, for equal ids the first preset wins
+ */
+void RecallIdTable::rebuild(const std::vector<LivePreset*>& presets) {
+    std::fill(mPresets.begin(), mPresets.end(), nullptr);
+    mUsed.fill(0);
+    for (auto* preset : presets) {
+        insert(preset);
+    }
+}
+
+/**
+ * @return the first id in [from, to) that is unused or equals ownId, -1 if there is none
+ */
+int RecallIdTable::findFree(int from, int to, int ownId) const {
+    for (int word = from / WORD_BITS; word * WORD_BITS < to; word++) {
+        uint64_t used = mUsed[word];
+        if (ownId >= 0 && ownId / WORD_BITS == word)
+            used &= ~(1ull << (ownId % WORD_BITS));
+        //ids below from count as used
+        if (word == from / WORD_BITS)
+            used |= (1ull << (from % WORD_BITS)) - 1;
+
+        if (~used) {
+            int id = word * WORD_BITS + std::countr_zero(~used);
+            return id < to ? id : -1;
+        }
+    }
+    return -1;
+}
\ No newline at end of file
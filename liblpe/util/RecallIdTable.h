@@ -0,0 +1,67 @@
+/******************************************************************************
+/ LivePresetsExtension
+/
+/ Maps recall ids to the presets that are recalled by MIDI or OSC values
+/
+/ Copyright (c) 2020 and later Dr. med. Frederik Bertling
+/
+/
+/ Permission is hereby granted, free of charge, to any person obtaining a copy
+/ of this software and associated documentation files (the "Software"), to deal
+/ in the Software without restriction, including without limitation the rights to
+/ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+/ of the Software, and to permit persons to whom the Software is furnished to
+/ do so, subject to the following conditions:
+/
+/ The above copyright notice and this permission notice shall be included in all
+/ copies or substantial portions of the Software.
+/
+/ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+/ EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+/ OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+/ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+/ HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+/ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/ FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+/ OTHER DEALINGS IN THE SOFTWARE.
+/
+******************************************************************************/
+
+#ifndef LPE_RECALLIDTABLE_H
+#define LPE_RECALLIDTABLE_H
+
+#include <array>
+#include <cstdint>
+#include <vector>
+#include <liblpe/util/util.h>
+
+class LivePreset;
+
+/**
+ * Dense table from recall id to preset covering all values LPE::onRecallPreset can decode, so recalling a preset by
+ * value is O(1). A bitmap of the used ids finds the next free id without visiting the presets
+ */
+class RecallIdTable {
+public:
+    //MIDI pitch and OSC values are decoded to 0..16383
+    static constexpr int SIZE = 16384;
+
+    RecallIdTable();
+
+    [[nodiscard]] LivePreset* find(int id) const;
+    [[nodiscard]] int getFreeId(const LivePreset* preset, int id) const;
+    void insert(LivePreset* preset);
+    void remove(const LivePreset* preset);
+    void rebuild(const std::vector<LivePreset*>& presets);
+private:
+    static constexpr int WORD_BITS = 64;
+
+    std::vector<LivePreset*> mPresets;
+    //set bits mark used ids
+    std::array<uint64_t, SIZE / WORD_BITS> mUsed{};
+
+    [[nodiscard]] int findFree(int from, int to, int ownId) const;
+};
+
+
+#endif //LPE_RECALLIDTABLE_H
\ No newline at end of file
@@ -0,0 +1,217 @@
+/******************************************************************************
+/ LivePresetsExtension
+/
+/ Measures the duration of preset recalls
+/
+/ Copyright (c) 2020 and later Dr. med. Frederik Bertling
+/
+/
+/ Permission is hereby granted, free of charge, to any person obtaining a copy
+/ of this software and associated documentation files (the "Software"), to deal
+/ in the Software without restriction, including without limitation the rights to
+/ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+/ of the Software, and to permit persons to whom the Software is furnished to
+/ do so, subject to the following conditions:
+/
+/ The above copyright notice and this permission notice shall be included in all
+/ copies or substantial portions of the Software.
+/
+/ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+/ EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+/ OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+/ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+/ HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+/ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/ FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+/ OTHER DEALINGS IN THE SOFTWARE.
+/
+******************************************************************************/
+
+#include <liblpe/util/RecallProfiler.h>
+#include <liblpe/LivePresetsExtension.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+//the master track has no GUID in the preset, it is recorded with an empty one
+static const GUID MASTER_GUID = GUID();
+static const std::string MASTER = "Master";
+
+static const char* const STAGE_NAMES[] = {
+        "total",
+        "master track",
+        "track",
+        "sends",
+        "fx enable/reorder",
+        "fx preset load",
+        "fx parameters",
+        "ui invalidate"
+};
+
+RecallProfiler::Timer::Timer(Stage stage) : mStage(stage), mIsRunning(g_lpe->mProfiler.isEnabled()) {
+    if (mIsRunning)
+        mStart = std::chrono::steady_clock::now();
+}
+
+RecallProfiler::Timer::Timer(Stage stage, const GUID& guid, const std::string& name) : Timer(stage) {
+    mGuid = &guid;
+    mName = &name;
+}
+
+RecallProfiler::Timer::~Timer() {
+    stop();
+}
+
+/**
+ * Stops the timer before it is destructed, only the first call is recorded
+ */
+void RecallProfiler::Timer::stop() {
+    if (!mIsRunning)
+        return;
+    mIsRunning = false;
+
+    std::chrono::duration<double, std::micro> duration = std::chrono::steady_clock::now() - mStart;
+    g_lpe->mProfiler.add(mStage, duration.count(), mGuid, mName);
+}
+
+/**
+ * Turns measuring on or off, the collected histograms are kept
+ */
+void RecallProfiler::setEnabled(bool enabled) {
+    mIsEnabled = enabled;
+    if (!mIsEnabled)
+        mPreset = nullptr;
+}
+
+bool RecallProfiler::isEnabled() const {
+    return mIsEnabled;
+}
+
+/**
+ * Starts the measurement of a new recall, all following stages are assigned to the given preset
+ */
+void RecallProfiler::begin(const GUID& preset, const std::string& name) {
+    mPreset = mIsEnabled ? &getHistograms(mPresets, preset, name) : nullptr;
+}
+
+/**
+ * Adds a measured duration
+ * @param stage the recall stage
+ * @param us the duration in microseconds
+ * @param guid the track for track stages, the fx for fx stages
+ * @param name the name of guid, only copied when guid is recorded for the first time
+ */
+void RecallProfiler::add(Stage stage, double us, const GUID* guid, const std::string* name) {
+    if (!mIsEnabled)
+        return;
+    if (mPreset)
+        (*mPreset)[stage].add(us);
+
+    switch (stage) {
+        case MASTERTRACK:
+            getHistograms(mTracks, MASTER_GUID, MASTER)[stage].add(us);
+            break;
+        case TRACK:
+            if (guid && name)
+                getHistograms(mTracks, *guid, *name)[stage].add(us);
+            break;
+        case FX_STRUCTURE:
+        case FX_PRESET:
+        case FX_PARAMETERS:
+            if (guid && name)
+                getHistograms(mPlugins, *guid, *name)[stage].add(us);
+            break;
+        default:
+            break;
+    }
+}
+
+RecallProfiler::Histograms& RecallProfiler::getHistograms(Entries& entries, const GUID& guid, const std::string& name) {
+    auto [it, isNew] = entries.try_emplace(guid);
+    if (isNew)
+        it->second.name = name;
+    return it->second.histograms;
+}
+
+/**
+ * Writes p50/p95/max of all stages as text file
+ * @return false when the file could not be written
+ */
+bool RecallProfiler::writeReport(const std::string& path) const {
+    FILE* file = fopen(path.data(), "w");
+    if (!file)
+        return false;
+
+    fprintf(file, "LivePresetsExtension recall report, all durations in microseconds\n");
+    fprintf(file, "percentiles are the upper bound of a histogram bucket (+-19%%)\n");
+    writeSection(file, "Presets", mPresets);
+    writeSection(file, "Tracks", mTracks);
+    writeSection(file, "Plugins", mPlugins);
+
+    fclose(file);
+    return true;
+}
+
+void RecallProfiler::clear() {
+    mPresets.clear();
+    mTracks.clear();
+    mPlugins.clear();
+    mPreset = nullptr;
+}
+
+/**
+ * Writes the entries sorted by name, entries with the same name are kept apart
+ */
+void RecallProfiler::writeSection(FILE* file, const char* title, const Entries& entries) {
+    std::vector<const Entry*> sorted;
+    sorted.reserve(entries.size());
+    for (const auto& entry : entries) {
+        sorted.push_back(&entry.second);
+    }
+    std::stable_sort(sorted.begin(), sorted.end(), [](const Entry* a, const Entry* b) { return a->name < b->name; });
+
+    fprintf(file, "\n%s\n", title);
+    for (const auto* entry : sorted) {
+        fprintf(file, "  %s\n", entry->name.data());
+        for (int stage = 0; stage < STAGE_COUNT; stage++) {
+            const auto& histogram = entry->histograms[stage];
+            if (histogram.getCount() == 0)
+                continue;
+
+            fprintf(file, "    %-20s count %6u  p50 %10.0f  p95 %10.0f  max %10.0f\n", STAGE_NAMES[stage],
+                    histogram.getCount(), histogram.getPercentile(0.5), histogram.getPercentile(0.95),
+                    histogram.getMax());
+        }
+    }
+}
+
+void RecallProfiler::Histogram::add(double us) {
+    int bucket = us < 1 ? 0 : (int) (4 * std::log2(us));
+    if (bucket >= BUCKETS)
+        bucket = BUCKETS - 1;
+
+    mBuckets[bucket]++;
+    mCount++;
+    if (us > mMax)
+        mMax = us;
+}
+
+double RecallProfiler::Histogram::getPercentile(double percentile) const {
+    auto rank = (unsigned int) std::ceil(percentile * mCount);
+    unsigned int count = 0;
+    for (int i = 0; i < BUCKETS; i++) {
+        count += mBuckets[i];
+        if (count >= rank && count > 0)
+            return std::min(std::exp2((i + 1) / 4.0), mMax);
+    }
+    return mMax;
+}
+
+double RecallProfiler::Histogram::getMax() const {
+    return mMax;
+}
+
+unsigned int RecallProfiler::Histogram::getCount() const {
+    return mCount;
+}
\ No newline at end of file
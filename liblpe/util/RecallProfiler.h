@@ -0,0 +1,115 @@
+/******************************************************************************
+/ LivePresetsExtension
+/
+/ Measures the duration of preset recalls
+/
+/ Copyright (c) 2020 and later Dr. med. Frederik Bertling
+/
+/
+/ Permission is hereby granted, free of charge, to any person obtaining a copy
+/ of this software and associated documentation files (the "Software"), to deal
+/ in the Software without restriction, including without limitation the rights to
+/ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+/ of the Software, and to permit persons to whom the Software is furnished to
+/ do so, subject to the following conditions:
+/
+/ The above copyright notice and this permission notice shall be included in all
+/ copies or substantial portions of the Software.
+/
+/ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+/ EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+/ OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+/ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+/ HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+/ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/ FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+/ OTHER DEALINGS IN THE SOFTWARE.
+/
+******************************************************************************/
+
+#ifndef LPE_RECALLPROFILER_H
+#define LPE_RECALLPROFILER_H
+
+#include <array>
+#include <chrono>
+#include <string>
+#include <unordered_map>
+#include <liblpe/util/util.h>
+
+/**
+ * Collects the durations of the recall stages in histograms per preset, per track and per plugin.
+ * Stages are nested, e.g. the duration of a track contains its sends and fxs.
+ * Profiling is off by default, disabled timers don't read the clock and nothing is recorded. Items are identified by
+ * their GUID, so items with the same name get their own histograms and the name is only copied on first use.
+ */
+class RecallProfiler {
+public:
+    enum Stage {
+        TOTAL,
+        MASTERTRACK,
+        TRACK,
+        SENDS,
+        FX_STRUCTURE,
+        FX_PRESET,
+        FX_PARAMETERS,
+        UI,
+        STAGE_COUNT
+    };
+
+    /**
+     * Measures the time from construction to destruction
+     */
+    class Timer {
+    public:
+        explicit Timer(Stage stage);
+        Timer(Stage stage, const GUID& guid, const std::string& name);
+        ~Timer();
+        void stop();
+    private:
+        Stage mStage;
+        const GUID* mGuid = nullptr;
+        const std::string* mName = nullptr;
+        std::chrono::steady_clock::time_point mStart;
+        bool mIsRunning;
+    };
+
+    void setEnabled(bool enabled);
+    [[nodiscard]] bool isEnabled() const;
+    void begin(const GUID& preset, const std::string& name);
+    void add(Stage stage, double us, const GUID* guid = nullptr, const std::string* name = nullptr);
+    bool writeReport(const std::string& path) const;
+    void clear();
+private:
+    //logarithmic buckets, four per octave starting at 1us
+    class Histogram {
+    public:
+        static const int BUCKETS = 112;
+
+        void add(double us);
+        [[nodiscard]] double getPercentile(double percentile) const;
+        [[nodiscard]] double getMax() const;
+        [[nodiscard]] unsigned int getCount() const;
+    private:
+        std::array<unsigned int, BUCKETS> mBuckets{};
+        unsigned int mCount = 0;
+        double mMax = 0;
+    };
+    using Histograms = std::array<Histogram, STAGE_COUNT>;
+    struct Entry {
+        std::string name;
+        Histograms histograms;
+    };
+    using Entries = std::unordered_map<GUID, Entry, GuidHash, GuidEqual>;
+
+    Entries mPresets;
+    Entries mTracks;
+    Entries mPlugins;
+    Histograms* mPreset = nullptr;
+    bool mIsEnabled = false;
+
+    static Histograms& getHistograms(Entries& entries, const GUID& guid, const std::string& name);
+    static void writeSection(FILE* file, const char* title, const Entries& entries);
+};
+
+
+#endif //LPE_RECALLPROFILER_H
\ No newline at end of file
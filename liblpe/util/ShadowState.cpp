@@ -0,0 +1,215 @@
+/******************************************************************************
+/ LivePresetsExtension
+/
+/ Remembers track, send and fx values that were written or observed
+/
+/ Copyright (c) 2020 and later Dr. med. Frederik Bertling
+/
+/
+/ Permission is hereby granted, free of charge, to any person obtaining a copy
+/ of this software and associated documentation files (the "Software"), to deal
+/ in the Software without restriction, including without limitation the rights to
+/ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+/ of the Software, and to permit persons to whom the Software is furnished to
+/ do so, subject to the following conditions:
+/
+/ The above copyright notice and this permission notice shall be included in all
+/ copies or substantial portions of the Software.
+/
+/ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+/ EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+/ OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+/ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+/ HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+/ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/ FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+/ OTHER DEALINGS IN THE SOFTWARE.
+/
+******************************************************************************/
+
+#include <liblpe/util/ShadowState.h>
+#include <liblpe/util/util.h>
+#include <algorithm>
+#include <array>
+#include <cfloat>
+
+/**
+ * Track values whose changes are reported by ProjectChangeListener, see SetSurfaceVolume and the other callbacks
+ */
+static bool isReportedTrackKey(const char* key) {
+    static const std::array<const char*, 9> keys = {
+            InternString("D_VOL"),
+            InternString("D_PAN"),
+            InternString("D_WIDTH"),
+            InternString("D_DUALPANL"),
+            InternString("D_DUALPANR"),
+            InternString("B_MUTE"),
+            InternString("I_SOLO"),
+            InternString("I_SELECTED"),
+            InternString("I_RECARM")
+    };
+    return std::find(keys.begin(), keys.end(), key) != keys.end();
+}
+
+/**
+ * Recalled values were captured from reaper and are written back unchanged, except for the track height, which is
+ * halved on recall and clamped to the minimum height by reaper
+ */
+static bool isClampedTrackKey(const char* key) {
+    static const char* height = InternString("I_HEIGHTOVERRIDE");
+    return key == height;
+}
+
+/**
+ * Called before a recall. When the project changed since the last recall, the values whose changes are not reported to
+ * control surfaces are removed, the reported ones were already removed one by one
+ * @param enabled false to always read the current values
+ */
+void ShadowState::begin(bool enabled) {
+    mIsEnabled = enabled;
+    mIsRecalling = true;
+    if (!mIsEnabled)
+        invalidate();
+    else if (mStateChangeCount != GetProjectStateChangeCount(nullptr))
+        invalidateUnreported();
+}
+
+/**
+ * Called after a recall, the undo point of the recall itself does not invalidate the cache
+ */
+void ShadowState::end() {
+    mIsRecalling = false;
+    mStateChangeCount = GetProjectStateChangeCount(nullptr);
+}
+
+/**
+ * Control surface notifications during a recall are caused by the recall itself and don't have to be handled
+ */
+bool ShadowState::isRecalling() const {
+    return mIsRecalling;
+}
+
+/**
+ * Writes a track value when it differs from the current value. The value of a key that reaper clamps is read back
+ * after the write and cached instead of the requested one
+ * @param key an interned key
+ * @param compare false when the value is known to differ
+ * @return true when the value was written
+ */
+bool ShadowState::setTrackValue(MediaTrack* track, const char* key, double value, bool compare) {
+    if (!mIsEnabled) {
+        bool write = !compare || GetMediaTrackInfo_Value(track, key) != value;
+        if (write)
+            SetMediaTrackInfo_Value(track, key, value);
+        return write;
+    }
+
+    auto& values = mTracks[track].mValues;
+    auto it = values.find(key);
+    double current = it != values.end() ? it->second : GetMediaTrackInfo_Value(track, key);
+    bool write = !compare || current != value;
+    if (write) {
+        SetMediaTrackInfo_Value(track, key, value);
+        current = isClampedTrackKey(key) ? GetMediaTrackInfo_Value(track, key) : value;
+    }
+    values[key] = current;
+    return write;
+}
+
+/**
+ * Writes a send value when it differs from the current value
+ * @param key an interned key
+ */
+void ShadowState::setSendValue(MediaTrack* track, int category, int sendIdx, const char* key, double value) {
+    if (!mIsEnabled) {
+        if (GetTrackSendInfo_Value(track, category, sendIdx, key) != value)
+            SetTrackSendInfo_Value(track, category, sendIdx, key, value);
+        return;
+    }
+
+    auto& sends = mTracks[track].mSends;
+    auto sendKey = std::make_tuple(category, sendIdx, key);
+    auto it = sends.find(sendKey);
+    double current = it != sends.end() ? it->second : GetTrackSendInfo_Value(track, category, sendIdx, key);
+    if (current != value)
+        SetTrackSendInfo_Value(track, category, sendIdx, key, value);
+    sends[sendKey] = value;
+}
+
+/**
+ * Writes a fx parameter when it differs from the current value. Recalled parameters were captured from the plugin,
+ * so they are not quantized again and the requested value is cached
+ * @param compare false when the value is known to differ
+ */
+void ShadowState::setFxParam(MediaTrack* track, int fx, int param, double value, bool compare) {
+    auto min = DBL_MIN;
+    auto max = DBL_MAX;
+
+    if (!mIsEnabled) {
+        if (!compare || TrackFX_GetParam(track, fx, param, &min, &max) != value)
+            TrackFX_SetParam(track, fx, param, value);
+        return;
+    }
+
+    auto& params = mTracks[track].mFxParams;
+    auto paramKey = getFxParamKey(fx, param);
+    auto it = params.find(paramKey);
+    double current = it != params.end() ? it->second : TrackFX_GetParam(track, fx, param, &min, &max);
+    if (!compare || current != value)
+        TrackFX_SetParam(track, fx, param, value);
+    params[paramKey] = value;
+}
+
+void ShadowState::invalidate() {
+    mTracks.clear();
+}
+
+/**
+ * Removes all values except the reported track values and fx parameters. Only volume and pan of sends are reported,
+ * so all sends are removed
+ */
+void ShadowState::invalidateUnreported() {
+    for (auto& [track, state] : mTracks) {
+        for (auto it = state.mValues.begin(); it != state.mValues.end();) {
+            if (isReportedTrackKey(it->first))
+                ++it;
+            else
+                it = state.mValues.erase(it);
+        }
+        state.mSends.clear();
+    }
+}
+
+void ShadowState::invalidateTrackValue(MediaTrack* track, const char* key) {
+    auto it = mTracks.find(track);
+    if (it != mTracks.end())
+        it->second.mValues.erase(InternString(key));
+}
+
+/**
+ * Send indices change when sends are created or removed
+ */
+void ShadowState::invalidateSends(MediaTrack* track) {
+    auto it = mTracks.find(track);
+    if (it != mTracks.end())
+        it->second.mSends.clear();
+}
+
+/**
+ * Fx indices change when fxs are added, removed or moved and all parameters change when a fx preset is loaded
+ */
+void ShadowState::invalidateFxs(MediaTrack* track) {
+    auto it = mTracks.find(track);
+    if (it != mTracks.end())
+        it->second.mFxParams.clear();
+}
+
+void ShadowState::invalidateFxParam(MediaTrack* track, int fx, int param) {
+    auto it = mTracks.find(track);
+    if (it != mTracks.end())
+        it->second.mFxParams.erase(getFxParamKey(fx, param));
+}
+
+long long ShadowState::getFxParamKey(int fx, int param) {
+    return ((long long) fx << 32) | (unsigned int) param;
+}
\ No newline at end of file
@@ -0,0 +1,76 @@
+/******************************************************************************
+/ LivePresetsExtension
+/
+/ Remembers track, send and fx values that were written or observed
+/
+/ Copyright (c) 2020 and later Dr. med. Frederik Bertling
+/
+/
+/ Permission is hereby granted, free of charge, to any person obtaining a copy
+/ of this software and associated documentation files (the "Software"), to deal
+/ in the Software without restriction, including without limitation the rights to
+/ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+/ of the Software, and to permit persons to whom the Software is furnished to
+/ do so, subject to the following conditions:
+/
+/ The above copyright notice and this permission notice shall be included in all
+/ copies or substantial portions of the Software.
+/
+/ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+/ EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+/ OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+/ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+/ HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+/ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/ FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+/ OTHER DEALINGS IN THE SOFTWARE.
+/
+******************************************************************************/
+
+#ifndef LPE_SHADOWSTATE_H
+#define LPE_SHADOWSTATE_H
+
+#include <map>
+#include <tuple>
+#include <unordered_map>
+#include <reaper_plugin.h>
+
+/**
+ * Cache of the values that were last written by a recall. Values that are known to be unchanged are neither read nor
+ * written again. Changes made by the user are reported by ProjectChangeListener and remove the affected values. Other
+ * changes of the project state remove the values whose changes are not reported, project and track list changes clear
+ * the whole cache. Values that are not cached are read from reaper like before.
+ */
+class ShadowState {
+public:
+    void begin(bool enabled);
+    void end();
+    [[nodiscard]] bool isRecalling() const;
+
+    bool setTrackValue(MediaTrack* track, const char* key, double value, bool compare = true);
+    void setSendValue(MediaTrack* track, int category, int sendIdx, const char* key, double value);
+    void setFxParam(MediaTrack* track, int fx, int param, double value, bool compare = true);
+
+    void invalidate();
+    void invalidateUnreported();
+    void invalidateTrackValue(MediaTrack* track, const char* key);
+    void invalidateSends(MediaTrack* track);
+    void invalidateFxs(MediaTrack* track);
+    void invalidateFxParam(MediaTrack* track, int fx, int param);
+private:
+    struct TrackState {
+        std::unordered_map<const char*, double> mValues;
+        std::map<std::tuple<int, int, const char*>, double> mSends;
+        std::unordered_map<long long, double> mFxParams;
+    };
+
+    std::unordered_map<MediaTrack*, TrackState> mTracks;
+    bool mIsEnabled = false;
+    bool mIsRecalling = false;
+    int mStateChangeCount = -1;
+
+    static long long getFxParamKey(int fx, int param);
+};
+
+
+#endif //LPE_SHADOWSTATE_H
\ No newline at end of file
@@ -0,0 +1,79 @@
+/******************************************************************************
+/ LivePresetsExtension
+/
+/ Maps track GUIDs to MediaTrack objects of a project
+/
+/ Copyright (c) 2020 and later Dr. med. Frederik Bertling
+/
+/
+/ Permission is hereby granted, free of charge, to any person obtaining a copy
+/ of this software and associated documentation files (the "Software"), to deal
+/ in the Software without restriction, including without limitation the rights to
+/ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+/ of the Software, and to permit persons to whom the Software is furnished to
+/ do so, subject to the following conditions:
+/
+/ The above copyright notice and this permission notice shall be included in all
+/ copies or substantial portions of the Software.
+/
+/ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+/ EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+/ OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+/ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+/ HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+/ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/ FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+/ OTHER DEALINGS IN THE SOFTWARE.
+/
+******************************************************************************/
+
+#include <liblpe/util/TrackIndex.h>
+
+/**
+ * Returns the track of the current project with the given guid
+ * @param guid the track guid
+ * @return the MediaTrack* or nullptr when there is no such track
+ */
+MediaTrack* TrackIndex::find(const GUID& guid) {
+    if (mBuiltGeneration != mGeneration)
+        rebuild();
+
+    auto it = mTracks.find(guid);
+    if (it != mTracks.end())
+        return it->second;
+
+    //a track may have been added before reaper notified us, only rescan when the track count differs
+    if (CountTracks(nullptr) != mTrackCount) {
+        rebuild();
+        it = mTracks.find(guid);
+        if (it != mTracks.end())
+            return it->second;
+    }
+    return nullptr;
+}
+
+/**
+ * Marks the index as outdated, called when tracks are added, removed or reordered
+ */
+void TrackIndex::invalidate() {
+    mGeneration++;
+}
+
+/**
+ * The generation changes every time the track list changes, caches that hold MediaTrack* can compare it
+ * to find out if they are still valid
+ */
+unsigned int TrackIndex::getGeneration() const {
+    return mGeneration;
+}
+
+void TrackIndex::rebuild() {
+    mTrackCount = CountTracks(nullptr);
+    mTracks.clear();
+    mTracks.reserve(mTrackCount);
+    for (int i = 0; i < mTrackCount; i++) {
+        MediaTrack* track = GetTrack(nullptr, i);
+        mTracks.emplace(*GetTrackGUID(track), track);
+    }
+    mBuiltGeneration = mGeneration;
+}
\ No newline at end of file
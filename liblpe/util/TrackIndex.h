@@ -0,0 +1,55 @@
+/******************************************************************************
+/ LivePresetsExtension
+/
+/ Maps track GUIDs to MediaTrack objects of a project
+/
+/ Copyright (c) 2020 and later Dr. med. Frederik Bertling
+/
+/
+/ Permission is hereby granted, free of charge, to any person obtaining a copy
+/ of this software and associated documentation files (the "Software"), to deal
+/ in the Software without restriction, including without limitation the rights to
+/ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+/ of the Software, and to permit persons to whom the Software is furnished to
+/ do so, subject to the following conditions:
+/
+/ The above copyright notice and this permission notice shall be included in all
+/ copies or substantial portions of the Software.
+/
+/ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+/ EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+/ OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+/ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+/ HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+/ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/ FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+/ OTHER DEALINGS IN THE SOFTWARE.
+/
+******************************************************************************/
+
+#ifndef LPE_TRACKINDEX_H
+#define LPE_TRACKINDEX_H
+
+#include <unordered_map>
+#include <liblpe/util/util.h>
+
+/**
+ * Lazily built hash index from track GUID to MediaTrack*. The index is invalidated by ProjectChangeListener whenever
+ * the track list changes and rebuilt on the next lookup, so resolving a track is O(1) instead of a scan over all tracks
+ */
+class TrackIndex {
+public:
+    [[nodiscard]] MediaTrack* find(const GUID& guid);
+    void invalidate();
+    [[nodiscard]] unsigned int getGeneration() const;
+private:
+    std::unordered_map<GUID, MediaTrack*, GuidHash, GuidEqual> mTracks;
+    unsigned int mGeneration = 1;
+    unsigned int mBuiltGeneration = 0;
+    int mTrackCount = -1;
+
+    void rebuild();
+};
+
+
+#endif //LPE_TRACKINDEX_H
\ No newline at end of file
@@ -28,7 +28,23 @@
 ******************************************************************************/
 
 #include <algorithm>
+#include <charconv>
+#include <unordered_set>
 #include <liblpe/util/util.h>
+#include <liblpe/LivePresetsExtension.h>
+#ifndef __cpp_lib_to_chars
+    //older libc++ (apple) and libstdc++ have no floating point std::from_chars/std::to_chars
+    #include <clocale>
+    #include <cstdlib>
+    #ifdef __APPLE__
+        #include <xlocale.h>
+    #endif
+
+static locale_t CLocale() {
+    static locale_t locale = newlocale(LC_ALL_MASK, "C", nullptr);
+    return locale;
+}
+#endif
 
 bool GuidsEqual(const GUID g1, const GUID g2) {
     return g1.Data1 == g2.Data1 &&
@@ -37,7 +53,13 @@ bool GuidsEqual(const GUID g1, const GUID g2) {
            std::equal(std::begin(g1.Data4), std::end(g1.Data4), std::begin(g2.Data4));
 }
 
+/**
+ * Resolves a track of the current project by its guid, uses the track index of the active model when available
+ */
 MediaTrack* GetTrackByGUID(GUID g1) {
+    if (g_lpe && g_lpe->mModel)
+        return g_lpe->mModel->mTrackIndex.find(g1);
+
     for (int i = 0; i < GetNumTracks(); i++) {
         MediaTrack* track = GetTrack(nullptr, i);
         if (GuidsEqual(*GetTrackGUID(track), g1)) {
@@ -108,4 +130,74 @@ GUID IntsToGuid(int i1, int i2, int i3, int i4) {
     data4[7] = i4 >> 24;
 
     return {data1, data2, data3, data4[0], data4[1], data4[2], data4[3], data4[4], data4[5], data4[6], data4[7]};
+}
+
+/**
+ * Stores a string once for the lifetime of the extension, equal strings return the same pointer so it can be used as
+ * key that is compared and hashed by address
+ */
+const char* InternString(const std::string& str) {
+    static std::unordered_set<std::string> strings;
+    return strings.insert(str).first->data();
+}
+
+/**
+ * Parses the leading integer of a chunk value like std::stoi but without locale and exceptions
+ * @return the number or 0 when str does not start with one
+ */
+int ParseInt(const char* str) {
+    int value = 0;
+    std::from_chars(str, str + strlen(str), value);
+    return value;
+}
+
+/**
+ * Parses the leading floating point number of a chunk value like std::stod but without locale and exceptions
+ * @return the number or 0 when str does not start with one
+ */
+double ParseDouble(const char* str) {
+#ifdef __cpp_lib_to_chars
+    double value = 0;
+    std::from_chars(str, str + strlen(str), value);
+    return value;
+#else
+    return strtod_l(str, nullptr, CLocale());
+#endif
+}
+
+/**
+ * Writes the shortest text that ParseDouble reads back to exactly value, "0.5" instead of "0.50000000000000000"
+ * @param buf receives the null terminated text, 32 chars are enough for every double
+ */
+void FormatDouble(double value, char* buf, size_t size) {
+#ifdef __cpp_lib_to_chars
+    auto res = std::to_chars(buf, buf + size - 1, value);
+    *(res.ec == std::errc() ? res.ptr : buf) = '\0';
+#else
+    //the first precision that reads back exactly, 17 digits always do
+    locale_t previous = uselocale(CLocale());
+    for (int precision = 15; precision <= 17; precision++) {
+        snprintf(buf, size, "%.*g", precision, value);
+        if (strtod_l(buf, nullptr, CLocale()) == value)
+            break;
+    }
+    uselocale(previous);
+#endif
+}
+
+/**
+ * Writes value with a fixed number of decimals like "%.17f", independent of the current locale
+ * @return false when buf is too small for the text
+ */
+bool FormatDoubleFixed(double value, int decimals, char* buf, size_t size) {
+#ifdef __cpp_lib_to_chars
+    auto res = std::to_chars(buf, buf + size - 1, value, std::chars_format::fixed, decimals);
+    *(res.ec == std::errc() ? res.ptr : buf) = '\0';
+    return res.ec == std::errc();
+#else
+    locale_t previous = uselocale(CLocale());
+    int length = snprintf(buf, size, "%.*f", decimals, value);
+    uselocale(previous);
+    return length >= 0 && (size_t) length < size;
+#endif
 }
\ No newline at end of file
@@ -31,8 +31,14 @@
 #define LPE_UTIL_H
 
 #include <iostream>
+#include <string>
 #include <set>
 #include <vector>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <unordered_map>
 #ifdef _WIN32
     #include <guiddef.h>
 #else
@@ -56,6 +62,30 @@ void AddControl(HWND parentHwnd, const char* name, int id, const char* widget, i
 void RemoveControl(HWND hwnd);
 void GuidToInts(GUID g1, int inOut[4]);
 GUID IntsToGuid(int i1, int i2, int i3, int i4);
+const char* InternString(const std::string& str);
+int ParseInt(const char* str);
+double ParseDouble(const char* str);
+void FormatDouble(double value, char* buf, size_t size);
+bool FormatDoubleFixed(double value, int decimals, char* buf, size_t size);
+
+/**
+ * Hash and equality functors to use GUIDs as keys of unordered containers
+ */
+struct GuidHash {
+    size_t operator()(const GUID& guid) const noexcept {
+        uint64_t a;
+        uint64_t b;
+        memcpy(&a, &guid, sizeof(a));
+        memcpy(&b, reinterpret_cast<const char*>(&guid) + sizeof(a), sizeof(b));
+        return std::hash<uint64_t>()(a ^ (b * 0x9E3779B97F4A7C15ull));
+    }
+};
+
+struct GuidEqual {
+    bool operator()(const GUID& a, const GUID& b) const {
+        return GuidsEqual(a, b);
+    }
+};
 
 template<typename T>
 void getPointerVector(std::vector<T>& base, std::vector<T*>& out) {
@@ -64,48 +94,58 @@ void getPointerVector(std::vector<T>& base, std::vector<T*>& out) {
     }
 }
 
-template<typename T, typename I>
-void compareVectors(std::vector<T>& as, std::vector<I>& bs, std::vector<T>& uniqueAs, std::vector<I>& uniqueBs,
-                    std::vector<std::pair<T, I>>& equals, bool (*compare)(T&, I&))
+/**
+ * Matches saved items to current items by key in O(n + m). Saved items whose key is not found in current are erased
+ * from saved, the order of the remaining saved items is kept. Items with equal keys are matched in order.
+ * @tparam Key the key type, hashed with Hash and compared with Equal
+ * @param saved the saved items, unmatched items are erased
+ * @param current the current items
+ * @param savedKey returns the key of a saved item
+ * @param currentKey returns the key of a current item
+ * @param onMatch called with every saved item and its matching current item
+ * @param onAdded called in order with every current item that has no matching saved item, after saved was updated so
+ * it may append to saved
+ */
+template<typename Key, typename Hash = std::hash<Key>, typename Equal = std::equal_to<Key>, typename T, typename I,
+         typename SavedKey, typename CurrentKey, typename OnMatch, typename OnAdded>
+void reconcile(std::vector<T>& saved, const std::vector<I>& current, SavedKey savedKey, CurrentKey currentKey,
+               OnMatch onMatch, OnAdded onAdded)
 {
-    //iterate through all a's and compare to all b's
-    //a's that are NOT found in b's are going to uniqueAs and removed from a's
-    //a's that are found in b's go to equals and removed from a's and b's
-    //b's that are left go to uniqueBs and are removed from b's
-    for (int i = 0; i < (int) as.size(); i++) {
-        int index;
-        auto a = as[i];
-        for (int j = 0; j < (int) bs.size(); j++) {
-            auto b = bs[j];
-            if (compare(a, b)) {
-                index = j;
-                equals.push_back(std::pair<T, I>(std::move(a), std::move(b)));
-                goto foundEqual;
-            }
+    constexpr size_t NONE = SIZE_MAX;
+
+    //first current index per key, current items with the same key are chained in ascending order by next
+    std::unordered_map<Key, size_t, Hash, Equal> heads;
+    heads.reserve(current.size());
+    std::vector<size_t> next(current.size(), NONE);
+    for (size_t i = current.size(); i-- > 0;) {
+        auto [it, inserted] = heads.try_emplace(currentKey(current[i]), i);
+        if (!inserted) {
+            next[i] = it->second;
+            it->second = i;
         }
-        uniqueAs.push_back(std::move(a));
-        continue;
-        foundEqual:;
-        bs.erase(bs.begin() + index);
-    }
-    as.clear();
-    for (auto itBs = bs.begin(); itBs != bs.end(); itBs++) {
-        auto b = *itBs;
-        uniqueBs.push_back(std::move(b));
     }
-    bs.clear();
-}
 
-template<typename T, typename I>
-void compareLists(std::vector<T>& as, std::vector<I>& bs, std::vector<T>& uniqueAs, std::vector<I>& uniqueBs,
-                  std::vector<std::pair<T, I>>& equals, bool (*compare)(T, I))
-{
-    static auto cmp = compare;
-    bool (*inverseCmp)(T&, I&) = [](T& a, I& b) -> bool {
-        return cmp(*b, *a);
-    };
+    std::vector<bool> matched(current.size(), false);
+    size_t kept = 0;
+    for (size_t i = 0; i < saved.size(); i++) {
+        auto it = heads.find(savedKey(saved[i]));
+        if (it == heads.end() || it->second == NONE)
+            continue;
 
-    compareVectors(as, bs, uniqueAs, uniqueBs, equals, *inverseCmp);
+        size_t j = it->second;
+        it->second = next[j];
+        matched[j] = true;
+        onMatch(saved[i], current[j]);
+        if (kept != i)
+            saved[kept] = std::move(saved[i]);
+        kept++;
+    }
+    saved.erase(saved.begin() + (long) kept, saved.end());
+
+    for (size_t j = 0; j < current.size(); j++) {
+        if (!matched[j])
+            onAdded(current[j]);
+    }
 }
 
 
@@ -18,8 +18,8 @@ TEST(Persist, ParameterInfoTest) {
    auto paramsRestored = ParameterInfo(nullptr, (ProjectStateContext*) &ctx);
 
    ASSERT_EQ(params.size(), paramsRestored.size());
-   for (auto& key : params.getKeys()) {
-       ASSERT_EQ(params.at(key).mValue, paramsRestored.at(key).mValue);
+   for (int i = 0; i < params.indexCount(); i++) {
+       ASSERT_EQ(params.valueAt(i), paramsRestored.valueAt(i));
    }
 
     for (int i = 0; i < 10; i ++) {
@@ -34,7 +34,32 @@ TEST(Persist, ParameterInfoTest) {
     auto paramsRestored2 = ParameterInfo(nullptr, (ProjectStateContext*) &ctx2);
 
     ASSERT_EQ(params.size(), paramsRestored2.size());
-    for (auto& key : params.getKeys()) {
-        ASSERT_EQ(params.at(key).mValue, paramsRestored2.at(key).mValue);
+    for (int i = 0; i < params.indexCount(); i++) {
+        ASSERT_EQ(params.valueAt(i), paramsRestored2.valueAt(i));
     }
-}
\ No newline at end of file
+}
+
+TEST(Persist, ParameterInfoNamedTest) {
+    static const std::array<const char*, 2> keys = {"D_VOL", "D_PAN"};
+    static const ParameterLayout layout(keys, keys.size());
+
+    auto params = ParameterInfo(nullptr, &layout);
+    params.setNamedValue(0, 0.5);
+    params.setNamedFilter(1, IGNORED);
+    params.insert("D_UNKNOWN", 2, RECALLED);
+
+    auto str = WDL_FastString();
+    params.persist(str);
+
+    //keys outside the layout are kept and persisted again
+    auto ctx = StringProjectStateContext(str);
+    auto restored = ParameterInfo(nullptr, &layout);
+    restored.initFromChunk((ProjectStateContext*) &ctx);
+    auto str2 = WDL_FastString();
+    restored.persist(str2);
+
+    ASSERT_EQ(0.5, restored.namedValueAt(0));
+    ASSERT_EQ(IGNORED, restored.namedFilterAt(1));
+    ASSERT_EQ(params.size(), restored.size());
+    ASSERT_STREQ(str.Get(), str2.Get());
+}
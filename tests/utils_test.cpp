@@ -1,51 +1,66 @@
 #include <gtest/gtest.h>
 #include <util/util.h>
+#include <util/ChunkCodec.h>
 #include <fcntl.h>
 
-bool (*cmp)(int&, long&) = [](int& a, long& b) -> bool {
-    return a == b;
-};
-
-TEST(util_test_addedAndRemoved, utils_test) {
-    std::vector<int> saved = {1, 1, 1, 2, 2, 2};
-    std::vector<long> current = {1, 2, 3};
-    std::vector<int> removed;
+struct Reconciled {
+    std::vector<int> saved;
     std::vector<long> added;
     std::vector<std::pair<int, long>> updated;
+};
 
-    compareVectors(saved, current, removed, added, updated, *cmp);
+Reconciled reconcileInts(std::vector<int> saved, const std::vector<long>& current) {
+    Reconciled result;
+    reconcile<long>(saved, current,
+            [](int a) -> long { return a; },
+            [](long b) -> long { return b; },
+            [&result](int a, long b) { result.updated.emplace_back(a, b); },
+            [&result](long b) { result.added.push_back(b); });
+    result.saved = saved;
+    return result;
+}
 
-    ASSERT_EQ(updated.size(), 2);
-    ASSERT_EQ(removed.size(), 4);
-    ASSERT_EQ(added.size(), 1);
+TEST(util_test_addedAndRemoved, utils_test) {
+    auto result = reconcileInts({1, 1, 1, 2, 2, 2}, {1, 2, 3});
+
+    ASSERT_EQ(result.updated.size(), 2);
+    ASSERT_EQ(result.saved.size(), 2);
+    ASSERT_EQ(result.added.size(), 1);
 }
 
 TEST(util_test_added, utils_test) {
-    std::vector<int> saved = {1, 2};
-    std::vector<long> current = {3, 1, 4, 2, 5, 6};
-    std::vector<int> removed;
-    std::vector<long> added;
-    std::vector<std::pair<int, long>> updated;
+    auto result = reconcileInts({1, 2}, {3, 1, 4, 2, 5, 6});
 
-    compareVectors(saved, current, removed, added, updated, *cmp);
-
-    ASSERT_EQ(updated.size(), 2);
-    ASSERT_EQ(removed.size(), 0);
-    ASSERT_EQ(added.size(), 4);
+    ASSERT_EQ(result.updated.size(), 2);
+    ASSERT_EQ(result.saved.size(), 2);
+    ASSERT_EQ(result.added, std::vector<long>({3, 4, 5, 6}));
 }
 
 TEST(util_test_removed, utils_test) {
-    std::vector<int> saved = {1, 1, 2, 2};
-    std::vector<long> current = {1, 2};
-    std::vector<int> removed;
-    std::vector<long> added;
-    std::vector<std::pair<int, long>> updated;
+    auto result = reconcileInts({1, 1, 2, 2}, {1, 2});
+
+    ASSERT_EQ(result.updated.size(), 2);
+    ASSERT_EQ(result.saved.size(), 2);
+    ASSERT_EQ(result.added.size(), 0);
+}
 
-    compareVectors(saved, current, removed, added, updated, *cmp);
+TEST(util_test_orderKept, utils_test) {
+    //equal keys are matched in order, the saved order is kept
+    using Pairs = std::vector<std::pair<int, int>>;
+    Pairs saved = {{3, 0}, {1, 1}, {3, 2}, {2, 3}, {3, 4}};
+    std::vector<int> current = {2, 3, 3, 4};
+    Pairs updated;
+    std::vector<int> added;
 
-    ASSERT_EQ(updated.size(), 2);
-    ASSERT_EQ(removed.size(), 2);
-    ASSERT_EQ(added.size(), 0);
+    reconcile<int>(saved, current,
+            [](const std::pair<int, int>& a) { return a.first; },
+            [](int b) { return b; },
+            [&updated](const std::pair<int, int>& a, int b) { updated.emplace_back(a.second, b); },
+            [&added](int b) { added.push_back(b); });
+
+    ASSERT_EQ(saved, Pairs({{3, 0}, {3, 2}, {2, 3}}));
+    ASSERT_EQ(updated, Pairs({{0, 3}, {2, 3}, {3, 2}}));
+    ASSERT_EQ(added, std::vector<int>({4}));
 }
 
 TEST(guid_int_transcoding, utils_test) {
@@ -62,4 +77,39 @@ TEST(guid_int_transcoding, utils_test) {
     GUID cGuid = IntsToGuid(inOut[0], inOut[1], inOut[2], inOut[3]);
 
     ASSERT_TRUE(GuidsEqual(oGuid, cGuid));
+}
+
+TEST(chunk_number_parsing, utils_test) {
+    ASSERT_EQ(ParseInt("42"), 42);
+    ASSERT_EQ(ParseInt("-3 trailing"), -3);
+    ASSERT_EQ(ParseInt("1.5"), 1);
+    ASSERT_EQ(ParseInt("abc"), 0);
+    ASSERT_EQ(ParseDouble("0.14285714285714285"), 0.14285714285714285);
+    ASSERT_EQ(ParseDouble("-2.5e-3"), -2.5e-3);
+    ASSERT_EQ(ParseDouble(""), 0.0);
+
+    char buf[32];
+    FormatDouble(0.5, buf, sizeof(buf));
+    ASSERT_STREQ(buf, "0.5");
+    FormatDouble(0.1 + 0.2, buf, sizeof(buf));
+    ASSERT_EQ(ParseDouble(buf), 0.1 + 0.2);
+    ASSERT_EQ(ParseDouble("0.50000000000000000"), 0.5);
+}
+
+TEST(chunk_codec_roundtrip, utils_test) {
+    std::string text = "<TRACKINFO\nGUID {0A1B2C3D-4E5F-6A7B-8C9D-0E1F2A3B4C5D}\nNAME \"two  spaces\"\n"
+            "D_VOL 0.50000000000000000 -1 0.1 007 -0 1.50 {0a1b2c3d-4e5f-6a7b-8c9d-0e1f2a3b4c5d}\n"
+            "GUID {0A1B2C3D-4E5F-6A7B-8C9D-0E1F2A3B4C5D}\n>\n";
+    std::string data;
+    std::string base64;
+    std::string decodedData;
+    std::string decoded;
+
+    ChunkCodec::encode(text, data);
+    ChunkCodec::encodeBase64(data, base64);
+    ASSERT_TRUE(ChunkCodec::decodeBase64(base64, decodedData));
+    ASSERT_EQ(decodedData, data);
+    ASSERT_TRUE(ChunkCodec::decode(decodedData, decoded));
+    ASSERT_EQ(decoded, text);
+    ASSERT_FALSE(ChunkCodec::decode(data.substr(0, data.size() - 1), decoded));
 }
\ No newline at end of file